@@ -17,6 +17,7 @@ limitations under the License.
 #include "backend.h"
 #include "dpdkArch.h"
 #include "dpdkAsmOpt.h"
+#include "dpdkCostReport.h"
 #include "dpdkCheckExternInvocation.h"
 #include "dpdkHelpers.h"
 #include "dpdkProgram.h"
@@ -105,16 +106,6 @@ void DpdkBackend::convert(const IR::ToplevelBlock *tlb) {
         new CheckExternInvocation(refMap, typeMap, &structure),
         new TypeWidthValidator(),
         new DpdkArchLast(),
-        new VisitFunctor([this, genContextJson] {
-            // Serialize context json object into user specified file
-            if (!options.ctxtFile.isNullOrEmpty()) {
-                std::ostream *out = openFile(options.ctxtFile, false);
-                if (out != nullptr) {
-                    genContextJson->serializeContextJson(out);
-                }
-                out->flush();
-            }
-        }),
         new ReplaceHdrMetaField(typeMap, refMap, &structure),
         // convert to assembly program
         convertToDpdk,
@@ -135,15 +126,36 @@ void DpdkBackend::convert(const IR::ToplevelBlock *tlb) {
 
     PassManager post_code_gen = {
         new EliminateUnusedAction(),
-        new DpdkAsmOptimization,
+        new DpdkAsmOptimization(options.enableDataflowOpt),
         new CopyPropagationAndElimination(typeMap),
         new CollectUsedMetadataField(used_fields),
         new RemoveUnusedMetadataFields(used_fields),
-        new ValidateTableKeys(),
+        new PackMatchKeyFields(options.enableKeyPacking),
+        new ValidateTableKeys(&structure),
         new ShortenTokenLength(),
     };
 
     dpdk_program = dpdk_program->apply(post_code_gen)->to<IR::DpdkAsmProgram>();
+
+    // Serialize context json object into user specified file; this is done after
+    // the assembly optimizations, as it reports the final key size of the tables.
+    if (!options.ctxtFile.isNullOrEmpty()) {
+        std::ostream *out = openFile(options.ctxtFile, false);
+        if (out != nullptr) {
+            genContextJson->serializeContextJson(out);
+            out->flush();
+        }
+    }
+
+    if (!options.costReportFile.isNullOrEmpty()) {
+        std::ostream *out = openFile(options.costReportFile, false);
+        if (out != nullptr) {
+            DpdkCostReport costReport;
+            dpdk_program->apply(costReport);
+            costReport.serializeCostReport(*out);
+            out->flush();
+        }
+    }
 }
 
 void DpdkBackend::codegen(std::ostream &out) const {
@@ -0,0 +1,82 @@
+/*
+Copyright 2022 Intel Corp.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "dpdkAsmCfg.h"
+
+namespace DPDK {
+
+bool DpdkAsmCFG::isTerminal(const IR::DpdkAsmStatement *s) {
+    return s->is<IR::DpdkJmpLabelStatement>() || s->is<IR::DpdkTxStatement>() ||
+           s->is<IR::DpdkDropStatement>() || s->is<IR::DpdkReturnStatement>();
+}
+
+void DpdkAsmCFG::addBlock(size_t begin, size_t end) {
+    BasicBlock b;
+    b.begin = begin;
+    b.end = end;
+    blocks.push_back(b);
+}
+
+DpdkAsmCFG::DpdkAsmCFG(const IR::IndexedVector<IR::DpdkAsmStatement> &stmts) : stmts(stmts) {
+    size_t begin = 0;
+    for (size_t i = 0; i < stmts.size(); i++) {
+        auto stmt = stmts.at(i);
+        if (stmt->is<IR::DpdkLabelStatement>() && i != begin) {
+            addBlock(begin, i);
+            begin = i;
+        }
+        if (stmt->is<IR::DpdkJmpStatement>() || isTerminal(stmt)) {
+            addBlock(begin, i + 1);
+            begin = i + 1;
+        }
+    }
+    if (begin < stmts.size())
+        addBlock(begin, stmts.size());
+
+    for (unsigned b = 0; b < blocks.size(); b++) {
+        if (auto label = stmts.at(blocks[b].begin)->to<IR::DpdkLabelStatement>())
+            labelBlock.emplace(label->label, b);
+    }
+
+    for (unsigned b = 0; b < blocks.size(); b++) {
+        auto &block = blocks[b];
+        auto stmt = last(b);
+        bool fallsThrough = !isTerminal(stmt);
+        if (auto jmp = stmt->to<IR::DpdkJmpStatement>()) {
+            // Jumps to labels outside of the sequence (e.g. LABEL_DROP in an
+            // action) leave the sequence.
+            auto target = labelBlock.find(jmp->label);
+            if (target != labelBlock.end()) {
+                block.taken = target->second;
+                blocks[target->second].preds.push_back(b);
+            } else {
+                block.exit = true;
+            }
+        } else if (!fallsThrough) {
+            block.exit = true;
+        }
+        if (fallsThrough) {
+            if (b + 1 < blocks.size()) {
+                block.fallthrough = b + 1;
+                blocks[b + 1].preds.push_back(b);
+            } else {
+                block.exit = true;
+            }
+        }
+    }
+}
+
+}  // namespace DPDK
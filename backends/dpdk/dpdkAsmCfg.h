@@ -0,0 +1,64 @@
+/*
+Copyright 2022 Intel Corp.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef BACKENDS_DPDK_DPDKASMCFG_H_
+#define BACKENDS_DPDK_DPDKASMCFG_H_
+
+#include <map>
+#include <vector>
+#include "ir/ir.h"
+
+namespace DPDK {
+
+/// Control flow graph of a DPDK instruction sequence (an action body or the
+/// apply block).  A basic block is a maximal run of instructions that can only
+/// be entered through its first instruction (the start of the sequence or a
+/// label) and only left through its last one (a jump, tx, drop or return).
+/// The graph refers to the statement vector it was built from, which must
+/// outlive it.
+class DpdkAsmCFG {
+ public:
+    struct BasicBlock {
+        /// Statements of the block are stmts[begin] .. stmts[end - 1].
+        size_t begin = 0;
+        size_t end = 0;
+        /// Block reached when the jump ending this block is taken, or -1.
+        int taken = -1;
+        /// Block reached by falling through the end of this block, or -1.
+        int fallthrough = -1;
+        /// Control can leave the instruction sequence from this block.
+        bool exit = false;
+        std::vector<unsigned> preds;
+    };
+
+    const IR::IndexedVector<IR::DpdkAsmStatement> &stmts;
+    std::vector<BasicBlock> blocks;
+    /// Maps a label to the block it starts.
+    std::map<cstring, unsigned> labelBlock;
+
+    explicit DpdkAsmCFG(const IR::IndexedVector<IR::DpdkAsmStatement> &stmts);
+
+    /// Returns true if control never continues past statement s.
+    static bool isTerminal(const IR::DpdkAsmStatement *s);
+    /// Last statement of block b.
+    const IR::DpdkAsmStatement *last(unsigned b) const { return stmts.at(blocks[b].end - 1); }
+
+ private:
+    void addBlock(size_t begin, size_t end);
+};
+
+}  // namespace DPDK
+#endif  /* BACKENDS_DPDK_DPDKASMCFG_H_ */
@@ -0,0 +1,698 @@
+/*
+Copyright 2022 Intel Corp.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "dpdkAsmDataflow.h"
+#include "dpdkUtils.h"
+
+namespace DPDK {
+
+DpdkInstrEffects::DpdkInstrEffects(const IR::DpdkAsmStatement *s) {
+    if (auto u = s->to<IR::DpdkUnaryStatement>()) {
+        reads.push_back(u->src);
+        write = u->dst;
+    } else if (auto b = s->to<IR::DpdkBinaryStatement>()) {
+        reads.push_back(b->src1);
+        reads.push_back(b->src2);
+        write = b->dst;
+    } else if (auto c = s->to<IR::DpdkCastStatement>()) {
+        reads.push_back(c->src);
+        write = c->dst;
+    } else if (auto r = s->to<IR::DpdkRegisterReadStatement>()) {
+        reads.push_back(r->index);
+        write = r->dst;
+    } else if (auto j = s->to<IR::DpdkJmpCondStatement>()) {
+        reads.push_back(j->src1);
+        reads.push_back(j->src2);
+    } else if (s->is<IR::DpdkJmpStatement>() || s->is<IR::DpdkLabelStatement>() ||
+               s->is<IR::DpdkDropStatement>() || s->is<IR::DpdkReturnStatement>() ||
+               s->is<IR::DpdkValidateStatement>() || s->is<IR::DpdkInvalidateStatement>()) {
+        // No field is read or written; validity is tracked separately.
+    } else if (auto rx = s->to<IR::DpdkRxStatement>()) {
+        write = rx->port;
+    } else if (auto tx = s->to<IR::DpdkTxStatement>()) {
+        reads.push_back(tx->port);
+    } else if (auto e = s->to<IR::DpdkEmitStatement>()) {
+        readsHeader = e->header;
+    } else if (auto e = s->to<IR::DpdkExtractStatement>()) {
+        reads.push_back(e->length);
+        writesHeader = e->header;
+    } else if (auto l = s->to<IR::DpdkLookaheadStatement>()) {
+        writesHeader = l->header;
+    } else if (auto c = s->to<IR::DpdkCounterCountStatement>()) {
+        reads.push_back(c->index);
+        reads.push_back(c->incr);
+    } else if (auto r = s->to<IR::DpdkRegisterWriteStatement>()) {
+        reads.push_back(r->index);
+        reads.push_back(r->src);
+    } else if (auto m = s->to<IR::DpdkMeterExecuteStatement>()) {
+        reads.push_back(m->index);
+        reads.push_back(m->length);
+        reads.push_back(m->color_in);
+        write = m->color_out;
+    } else if (auto m = s->to<IR::DpdkMeterDeclStatement>()) {
+        reads.push_back(m->size);
+    } else if (auto r = s->to<IR::DpdkRegisterDeclStatement>()) {
+        reads.push_back(r->size);
+        reads.push_back(r->init_val);
+    } else {
+        barrier = true;
+    }
+}
+
+void DataflowOptimization::Facts::kill(cstring operand) {
+    values.erase(operand);
+    for (auto it = values.begin(); it != values.end();) {
+        if (it->second->is<IR::Member>() && it->second->toString() == operand)
+            it = values.erase(it);
+        else
+            ++it;
+    }
+}
+
+void DataflowOptimization::Facts::killHeader(cstring header) {
+    cstring prefix = header + ".";
+    for (auto it = values.begin(); it != values.end();) {
+        if (it->first.startsWith(prefix) ||
+            (it->second->is<IR::Member>() && it->second->toString().startsWith(prefix)))
+            it = values.erase(it);
+        else
+            ++it;
+    }
+}
+
+static bool sameValue(const IR::Expression *a, const IR::Expression *b) {
+    if (a == b)
+        return true;
+    auto ca = a->to<IR::Constant>();
+    auto cb = b->to<IR::Constant>();
+    if (ca && cb)
+        return ca->value == cb->value;
+    if (a->is<IR::Member>() && b->is<IR::Member>())
+        return a->toString() == b->toString();
+    return false;
+}
+
+void DataflowOptimization::Facts::meet(const Facts &other) {
+    if (!other.reached)
+        return;
+    if (!reached) {
+        *this = other;
+        return;
+    }
+    for (auto it = values.begin(); it != values.end();) {
+        auto o = other.values.find(it->first);
+        if (o == other.values.end() || !sameValue(it->second, o->second))
+            it = values.erase(it);
+        else
+            ++it;
+    }
+    for (auto it = valid.begin(); it != valid.end();) {
+        auto o = other.valid.find(it->first);
+        if (o == other.valid.end() || o->second != it->second)
+            it = valid.erase(it);
+        else
+            ++it;
+    }
+}
+
+bool DataflowOptimization::Facts::operator==(const Facts &other) const {
+    if (reached != other.reached || valid != other.valid ||
+        values.size() != other.values.size())
+        return false;
+    for (auto &v : values) {
+        auto o = other.values.find(v.first);
+        if (o == other.values.end() || !sameValue(v.second, o->second))
+            return false;
+    }
+    return true;
+}
+
+bool DataflowOptimization::Liveness::isLive(cstring operand) const {
+    if (all)
+        return operands.count(operand) == 0;
+    if (operands.count(operand))
+        return true;
+    for (auto h : headers) {
+        if (operand.startsWith(h + "."))
+            return true;
+    }
+    return false;
+}
+
+void DataflowOptimization::Liveness::use(cstring operand) {
+    if (all)
+        operands.erase(operand);
+    else
+        operands.insert(operand);
+}
+
+void DataflowOptimization::Liveness::def(cstring operand) {
+    if (all)
+        operands.insert(operand);
+    else
+        operands.erase(operand);
+}
+
+void DataflowOptimization::Liveness::useHeader(cstring header) {
+    if (all) {
+        cstring prefix = header + ".";
+        for (auto it = operands.begin(); it != operands.end();) {
+            if (it->startsWith(prefix))
+                it = operands.erase(it);
+            else
+                ++it;
+        }
+    } else {
+        headers.insert(header);
+    }
+}
+
+void DataflowOptimization::Liveness::defHeader(cstring header) {
+    // Dead header fields cannot be represented when everything else is live;
+    // keeping them live is conservative.
+    if (all)
+        return;
+    headers.erase(header);
+    cstring prefix = header + ".";
+    for (auto it = operands.begin(); it != operands.end();) {
+        if (it->startsWith(prefix))
+            it = operands.erase(it);
+        else
+            ++it;
+    }
+}
+
+void DataflowOptimization::Liveness::join(const Liveness &other) {
+    if (all) {
+        // Keep as dead only the operands which are dead on both sides.
+        for (auto it = operands.begin(); it != operands.end();) {
+            if (other.isLive(*it))
+                it = operands.erase(it);
+            else
+                ++it;
+        }
+    } else if (other.all) {
+        std::set<cstring> dead;
+        for (auto o : other.operands) {
+            if (!isLive(o))
+                dead.insert(o);
+        }
+        all = true;
+        operands = dead;
+        headers.clear();
+    } else {
+        operands.insert(other.operands.begin(), other.operands.end());
+        headers.insert(other.headers.begin(), other.headers.end());
+    }
+}
+
+bool DataflowOptimization::Liveness::operator==(const Liveness &other) const {
+    return all == other.all && operands == other.operands && headers == other.headers;
+}
+
+const IR::Type_Bits *DataflowOptimization::typeOf(const IR::Expression *e) const {
+    if (auto t = e->type ? e->type->to<IR::Type_Bits>() : nullptr)
+        return t;
+    auto it = operandTypes.find(e->toString());
+    if (it != operandTypes.end())
+        return it->second;
+    return nullptr;
+}
+
+// Constants are only propagated into unsigned operands which can hold them as
+// an immediate value.
+bool DataflowOptimization::fitsInto(const IR::Constant *c, const IR::Expression *dst) const {
+    auto type = typeOf(dst);
+    if (!type || type->isSigned || type->width_bits() > 64)
+        return false;
+    return c->value >= 0 && c->value < (big_int(1) << type->width_bits());
+}
+
+const IR::Expression *DataflowOptimization::lookup(const IR::Expression *e, const Facts &facts,
+                                                   bool allowConst) const {
+    if (!e || !e->is<IR::Member>())
+        return e;
+    auto it = facts.values.find(e->toString());
+    if (it == facts.values.end())
+        return e;
+    if (it->second->is<IR::Constant>() && !allowConst)
+        return e;
+    return it->second;
+}
+
+const IR::Constant *DataflowOptimization::constantValue(const IR::Expression *e,
+                                                        const Facts &facts) const {
+    return lookup(e, facts, true)->to<IR::Constant>();
+}
+
+// Record that dst now holds the value of src.  Only copies between operands of
+// the same type are recorded, so that a use of dst can be replaced by src
+// without changing its width.
+void DataflowOptimization::define(const IR::Expression *dst, const IR::Expression *src,
+                                  Facts &facts) const {
+    cstring name = dst->toString();
+    facts.kill(name);
+    if (!dst->is<IR::Member>() || !src)
+        return;
+    if (auto c = src->to<IR::Constant>()) {
+        if (fitsInto(c, dst))
+            facts.values[name] = src;
+    } else if (src->is<IR::Member>() && src->toString() != name) {
+        auto dt = typeOf(dst);
+        auto st = typeOf(src);
+        if (dt && st && dt->width_bits() == st->width_bits() && dt->isSigned == st->isSigned &&
+            dt->width_bits() <= 64)
+            facts.values[name] = src;
+    }
+}
+
+const IR::DpdkAsmStatement *DataflowOptimization::foldBinary(const IR::DpdkBinaryStatement *s,
+                                                             const Facts &facts) const {
+    auto type = typeOf(s->dst);
+    auto c1 = constantValue(s->src1, facts);
+    auto c2 = constantValue(s->src2, facts);
+    if (!type || type->isSigned || type->width_bits() > 64 || !c1 || !c2 ||
+        c1->value < 0 || c2->value < 0)
+        return nullptr;
+    unsigned width = type->width_bits();
+    big_int modulus = big_int(1) << width;
+    big_int v1 = c1->value, v2 = c2->value, result;
+    if (s->is<IR::DpdkAddStatement>()) {
+        result = v1 + v2;
+    } else if (s->is<IR::DpdkSubStatement>()) {
+        result = v1 + modulus - (v2 % modulus);
+    } else if (s->is<IR::DpdkAndStatement>()) {
+        result = v1 & v2;
+    } else if (s->is<IR::DpdkOrStatement>()) {
+        result = v1 | v2;
+    } else if (s->is<IR::DpdkXorStatement>()) {
+        result = v1 ^ v2;
+    } else if (s->is<IR::DpdkShlStatement>()) {
+        result = v2 >= width ? big_int(0) : big_int(v1 << static_cast<unsigned>(v2));
+    } else if (s->is<IR::DpdkShrStatement>()) {
+        result = v2 >= width ? big_int(0) : big_int(v1 >> static_cast<unsigned>(v2));
+    } else {
+        return nullptr;
+    }
+    result = result % modulus;
+    return new IR::DpdkMovStatement(s->dst, new IR::Constant(type, result, 16));
+}
+
+int DataflowOptimization::jumpOutcome(const IR::DpdkJmpStatement *jmp,
+                                      const Facts &facts) const {
+    if (jmp->is<IR::DpdkJmpLabelStatement>())
+        return 1;
+    if (auto jh = jmp->to<IR::DpdkJmpHeaderStatement>()) {
+        auto it = facts.valid.find(jh->header->toString());
+        if (it == facts.valid.end())
+            return -1;
+        bool valid = it->second;
+        return jh->is<IR::DpdkJmpIfValidStatement>() == valid ? 1 : 0;
+    }
+    if (auto jc = jmp->to<IR::DpdkJmpCondStatement>()) {
+        auto c1 = constantValue(jc->src1, facts);
+        auto c2 = constantValue(jc->src2, facts);
+        if (!c1 || !c2 || c1->value < 0 || c2->value < 0)
+            return -1;
+        bool taken;
+        if (jc->is<IR::DpdkJmpEqualStatement>())
+            taken = c1->value == c2->value;
+        else if (jc->is<IR::DpdkJmpNotEqualStatement>())
+            taken = c1->value != c2->value;
+        else if (jc->is<IR::DpdkJmpGreaterEqualStatement>())
+            taken = c1->value >= c2->value;
+        else if (jc->is<IR::DpdkJmpGreaterStatement>())
+            taken = c1->value > c2->value;
+        else if (jc->is<IR::DpdkJmpLessOrEqualStatement>())
+            taken = c1->value <= c2->value;
+        else if (jc->is<IR::DpdkJmpLessStatement>())
+            taken = c1->value < c2->value;
+        else
+            return -1;
+        return taken ? 1 : 0;
+    }
+    // Jumps on table hit/miss and action run depend on the lookup result.
+    return -1;
+}
+
+const IR::DpdkAsmStatement *DataflowOptimization::simplify(const IR::DpdkAsmStatement *s,
+                                                           Facts &facts) const {
+    if (auto jmp = s->to<IR::DpdkJmpStatement>()) {
+        switch (jumpOutcome(jmp, facts)) {
+        case 0:
+            return nullptr;
+        case 1:
+            if (jmp->is<IR::DpdkJmpLabelStatement>())
+                return s;
+            return new IR::DpdkJmpLabelStatement(jmp->label);
+        default:
+            break;
+        }
+        if (auto jc = jmp->to<IR::DpdkJmpCondStatement>()) {
+            // DPDK does not accept a constant as first operand of a jump.
+            auto src1 = lookup(jc->src1, facts, false);
+            auto src2 = lookup(jc->src2, facts, true);
+            if (src1 != jc->src1 || src2 != jc->src2) {
+                auto copy = jc->clone();
+                copy->src1 = src1;
+                copy->src2 = src2;
+                return copy;
+            }
+        }
+        return s;
+    }
+
+    if (auto mv = s->to<IR::DpdkMovStatement>()) {
+        auto src = lookup(mv->src, facts, true);
+        if (auto c = src->to<IR::Constant>()) {
+            if (!fitsInto(c, mv->dst))
+                src = mv->src;
+        }
+        cstring dst = mv->dst->toString();
+        auto known = facts.values.find(dst);
+        if (src->toString() == dst ||
+            (known != facts.values.end() && sameValue(known->second, src)))
+            return nullptr;  // the destination already holds this value
+        define(mv->dst, src, facts);
+        if (src == mv->src)
+            return s;
+        return new IR::DpdkMovStatement(mv->dst, src);
+    }
+
+    if (auto un = s->to<IR::DpdkUnaryStatement>()) {
+        auto src = lookup(un->src, facts, true);
+        facts.kill(un->dst->toString());
+        if (src == un->src)
+            return s;
+        auto copy = un->clone();
+        copy->src = src;
+        return copy;
+    }
+
+    if (auto bin = s->to<IR::DpdkBinaryStatement>()) {
+        if (auto folded = foldBinary(bin, facts)) {
+            auto mv = folded->to<IR::DpdkMovStatement>();
+            define(mv->dst, mv->src, facts);
+            return folded;
+        }
+        // The first source is also the destination and must stay as it is.
+        auto src2 = lookup(bin->src2, facts, true);
+        facts.kill(bin->dst->toString());
+        if (src2 == bin->src2)
+            return s;
+        auto copy = bin->clone();
+        copy->src2 = src2;
+        return copy;
+    }
+
+    if (auto v = s->to<IR::DpdkValidateStatement>()) {
+        cstring hdr = v->header->toString();
+        auto it = facts.valid.find(hdr);
+        if (it != facts.valid.end() && it->second)
+            return nullptr;
+        facts.valid[hdr] = true;
+        return s;
+    }
+
+    if (auto v = s->to<IR::DpdkInvalidateStatement>()) {
+        cstring hdr = v->header->toString();
+        auto it = facts.valid.find(hdr);
+        if (it != facts.valid.end() && !it->second)
+            return nullptr;
+        facts.valid[hdr] = false;
+        return s;
+    }
+
+    DpdkInstrEffects effects(s);
+    if (effects.barrier) {
+        facts.clear();
+        return s;
+    }
+    if (effects.write)
+        facts.kill(effects.write->toString());
+    if (effects.writesHeader) {
+        cstring hdr = effects.writesHeader->toString();
+        facts.killHeader(hdr);
+        if (s->is<IR::DpdkExtractStatement>())
+            facts.valid[hdr] = true;
+    }
+    return s;
+}
+
+void DataflowOptimization::transferLiveness(const IR::DpdkAsmStatement *s,
+                                            Liveness &live) const {
+    DpdkInstrEffects effects(s);
+    if (effects.barrier) {
+        live.all = true;
+        live.operands.clear();
+        live.headers.clear();
+        return;
+    }
+    if (effects.write)
+        live.def(effects.write->toString());
+    if (effects.writesHeader)
+        live.defHeader(effects.writesHeader->toString());
+    for (auto r : effects.reads) {
+        if (r && r->is<IR::Member>())
+            live.use(r->toString());
+    }
+    if (effects.readsHeader)
+        live.useHeader(effects.readsHeader->toString());
+}
+
+bool DataflowOptimization::isDeadStore(const IR::DpdkAsmStatement *s,
+                                       const Liveness &live) const {
+    const IR::Expression *dst = nullptr;
+    if (auto u = s->to<IR::DpdkUnaryStatement>())
+        dst = u->dst;
+    else if (auto b = s->to<IR::DpdkBinaryStatement>())
+        dst = b->dst;
+    else if (auto c = s->to<IR::DpdkCastStatement>())
+        dst = c->dst;
+    else if (auto r = s->to<IR::DpdkRegisterReadStatement>())
+        dst = r->dst;
+    if (!dst || !dst->is<IR::Member>())
+        return false;
+    cstring name = dst->toString();
+    return !keepAlive.count(name) && !live.isLive(name);
+}
+
+// Forward pass: computes the facts at the entry of each block, then rewrites
+// the statements.  Returns true if anything changed.
+bool DataflowOptimization::propagate(IR::IndexedVector<IR::DpdkAsmStatement> &stmts) const {
+    DpdkAsmCFG cfg(stmts);
+    if (cfg.blocks.empty())
+        return false;
+    std::vector<Facts> in(cfg.blocks.size());
+    in[0].reached = true;
+    std::set<unsigned> worklist = {0};
+    while (!worklist.empty()) {
+        unsigned b = *worklist.begin();
+        worklist.erase(worklist.begin());
+        auto &block = cfg.blocks[b];
+        Facts facts = in[b];
+        for (size_t i = block.begin; i < block.end; i++)
+            simplify(stmts.at(i), facts);
+        int outcome = -1;
+        auto jmp = cfg.last(b)->to<IR::DpdkJmpStatement>();
+        if (jmp)
+            outcome = jumpOutcome(jmp, facts);
+        auto flowTo = [&](int succ, bool taken) {
+            if (succ < 0)
+                return;
+            Facts edge = facts;
+            if (auto jh = jmp ? jmp->to<IR::DpdkJmpHeaderStatement>() : nullptr) {
+                bool ifValid = jh->is<IR::DpdkJmpIfValidStatement>();
+                edge.valid[jh->header->toString()] = (ifValid == taken);
+            }
+            Facts old = in[succ];
+            in[succ].meet(edge);
+            if (!(old == in[succ]))
+                worklist.insert(succ);
+        };
+        if (outcome != 0)
+            flowTo(block.taken, true);
+        if (outcome != 1)
+            flowTo(block.fallthrough, false);
+    }
+
+    bool changed = false;
+    IR::IndexedVector<IR::DpdkAsmStatement> result;
+    for (unsigned b = 0; b < cfg.blocks.size(); b++) {
+        auto &block = cfg.blocks[b];
+        if (!in[b].reached) {
+            changed = true;
+            continue;
+        }
+        Facts facts = in[b];
+        for (size_t i = block.begin; i < block.end; i++) {
+            auto stmt = stmts.at(i);
+            auto newStmt = simplify(stmt, facts);
+            if (newStmt != stmt)
+                changed = true;
+            if (newStmt)
+                result.push_back(newStmt);
+        }
+    }
+    if (changed)
+        stmts = result;
+    return changed;
+}
+
+// Backward pass: computes liveness at the end of each block and removes
+// instructions whose only effect is writing an operand which is not live.
+bool DataflowOptimization::eliminateDeadStores(IR::IndexedVector<IR::DpdkAsmStatement> &stmts,
+                                               const Liveness &exitLive) const {
+    DpdkAsmCFG cfg(stmts);
+    std::vector<Liveness> liveIn(cfg.blocks.size());
+    auto liveOut = [&](unsigned b) {
+        auto &block = cfg.blocks[b];
+        Liveness live;
+        if (block.exit)
+            live.join(exitLive);
+        if (block.taken >= 0)
+            live.join(liveIn[block.taken]);
+        if (block.fallthrough >= 0)
+            live.join(liveIn[block.fallthrough]);
+        return live;
+    };
+
+    bool updated = true;
+    while (updated) {
+        updated = false;
+        for (unsigned b = cfg.blocks.size(); b-- > 0;) {
+            auto &block = cfg.blocks[b];
+            Liveness live = liveOut(b);
+            for (size_t i = block.end; i-- > block.begin;) {
+                auto stmt = stmts.at(i);
+                if (!isDeadStore(stmt, live))
+                    transferLiveness(stmt, live);
+            }
+            if (!(live == liveIn[b])) {
+                liveIn[b] = live;
+                updated = true;
+            }
+        }
+    }
+
+    bool changed = false;
+    std::vector<bool> dead(stmts.size(), false);
+    for (unsigned b = 0; b < cfg.blocks.size(); b++) {
+        auto &block = cfg.blocks[b];
+        Liveness live = liveOut(b);
+        for (size_t i = block.end; i-- > block.begin;) {
+            auto stmt = stmts.at(i);
+            if (isDeadStore(stmt, live)) {
+                LOG3("Removing dead store " << stmt);
+                dead[i] = true;
+                changed = true;
+            } else {
+                transferLiveness(stmt, live);
+            }
+        }
+    }
+    if (!changed)
+        return false;
+    IR::IndexedVector<IR::DpdkAsmStatement> result;
+    for (size_t i = 0; i < stmts.size(); i++) {
+        if (!dead[i])
+            result.push_back(stmts.at(i));
+    }
+    stmts = result;
+    return true;
+}
+
+const IR::Node *DataflowOptimization::preorder(IR::DpdkAsmProgram *p) {
+    operandTypes.clear();
+    keepAlive = {"m.pna_main_output_metadata_output_port",
+                 "m.psa_ingress_output_metadata_drop",
+                 "m.psa_ingress_output_metadata_egress_port"};
+    recirculates = false;
+
+    for (auto st : p->structType) {
+        if (isMetadataStruct(st)) {
+            for (auto f : st->fields) {
+                if (auto t = f->type->to<IR::Type_Bits>())
+                    operandTypes["m." + f->name.name] = t;
+            }
+            continue;
+        }
+        for (auto f : st->fields) {
+            auto tn = f->type->to<IR::Type_Name>();
+            if (!tn)
+                continue;
+            auto hdr = p->headerType.getDeclaration<IR::DpdkHeaderType>(tn->path->name.name);
+            if (!hdr)
+                continue;
+            for (auto hf : hdr->fields) {
+                if (auto t = hf->type->to<IR::Type_Bits>())
+                    operandTypes["h." + f->name.name + "." + hf->name.name] = t;
+            }
+        }
+    }
+
+    auto keepKeys = [this](const IR::Key *keys) {
+        if (!keys)
+            return;
+        for (auto ke : keys->keyElements)
+            keepAlive.insert(ke->expression->toString());
+    };
+    for (auto t : p->tables)
+        keepKeys(t->match_keys);
+    for (auto l : p->learners)
+        keepKeys(l->match_keys);
+    for (auto s : p->selectors) {
+        keepKeys(s->selectors);
+        keepAlive.insert(s->group_id->toString());
+        keepAlive.insert(s->member_id->toString());
+    }
+
+    forAllMatching<IR::DpdkRecirculateStatement>(p, [this](const IR::DpdkRecirculateStatement *) {
+        recirculates = true;
+    });
+    return p;
+}
+
+const IR::Node *DataflowOptimization::postorder(IR::DpdkAction *a) {
+    // Everything an action writes may be read after it returns.
+    Liveness exitLive;
+    exitLive.all = true;
+    bool changed = propagate(a->statements);
+    changed |= eliminateDeadStores(a->statements, exitLive);
+    if (changed)
+        LOG2("Dataflow optimization of action " << a->name);
+    return a;
+}
+
+const IR::Node *DataflowOptimization::postorder(IR::DpdkListStatement *l) {
+    // After the apply block the packet has been emitted and metadata is only
+    // read by the target through the fields in keepAlive, unless the packet
+    // is recirculated.
+    Liveness exitLive;
+    if (recirculates) {
+        exitLive.all = true;
+    } else {
+        exitLive.headers.insert("h");
+        exitLive.operands = keepAlive;
+    }
+    bool changed = propagate(l->statements);
+    changed |= eliminateDeadStores(l->statements, exitLive);
+    if (changed)
+        LOG2("Dataflow optimization of the apply block");
+    return l;
+}
+
+}  // namespace DPDK
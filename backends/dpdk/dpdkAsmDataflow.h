@@ -0,0 +1,121 @@
+/*
+Copyright 2022 Intel Corp.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef BACKENDS_DPDK_DPDKASMDATAFLOW_H_
+#define BACKENDS_DPDK_DPDKASMDATAFLOW_H_
+
+#include <map>
+#include <set>
+#include "ir/ir.h"
+#include "lib/gmputil.h"
+#include "dpdkAsmCfg.h"
+
+namespace DPDK {
+
+/// Operands read and written by a DPDK instruction.  Operands are identified
+/// by their string form (e.g. "m.ingress_tmp" or "h.ipv4.ttl"); a header
+/// operand stands for all fields of the header.
+struct DpdkInstrEffects {
+    std::vector<const IR::Expression *> reads;
+    const IR::Expression *write = nullptr;
+    const IR::Expression *readsHeader = nullptr;
+    const IR::Expression *writesHeader = nullptr;
+    /// Instruction with effects the optimizer does not model (table lookups,
+    /// extern calls, learn, mirror...): it may read and write anything.
+    bool barrier = false;
+
+    explicit DpdkInstrEffects(const IR::DpdkAsmStatement *s);
+};
+
+/// This pass optimizes each action and the apply block over their control flow
+/// graph (see DpdkAsmCFG), so that it sees across jumps and labels:
+///  - copy and constant propagation, using the copies and constants available
+///    on every path reaching an instruction;
+///  - constant folding of arithmetic on known values and of conditional jumps
+///    on known operands or known header validity; blocks that become
+///    unreachable are removed;
+///  - removal of moves storing a value the destination already holds, and of
+///    validate/invalidate of headers whose validity is already known;
+///  - dead store elimination based on liveness.
+/// Table lookups and externs are treated as reading and clobbering everything.
+class DataflowOptimization : public Transform {
+ public:
+    /// Copies, constants and header validity known to hold at a program point.
+    struct Facts {
+        bool reached = false;
+        std::map<cstring, const IR::Expression *> values;
+        std::map<cstring, bool> valid;
+
+        void kill(cstring operand);
+        void killHeader(cstring header);
+        void clear() { values.clear(); valid.clear(); }
+        void meet(const Facts &other);
+        bool operator==(const Facts &other) const;
+    };
+
+    /// Operands which may be read later.  When 'all' is set every operand is
+    /// live except those listed in 'operands'.
+    struct Liveness {
+        bool all = false;
+        std::set<cstring> operands;
+        std::set<cstring> headers;
+
+        bool isLive(cstring operand) const;
+        void use(cstring operand);
+        void def(cstring operand);
+        void useHeader(cstring header);
+        void defHeader(cstring header);
+        void join(const Liveness &other);
+        bool operator==(const Liveness &other) const;
+    };
+
+ private:
+    std::map<cstring, const IR::Type_Bits *> operandTypes;
+    /// Operands read by the target outside of the instruction stream.
+    std::set<cstring> keepAlive;
+    /// Metadata survives the end of the apply block when packets recirculate.
+    bool recirculates = false;
+
+    const IR::Type_Bits *typeOf(const IR::Expression *e) const;
+    bool fitsInto(const IR::Constant *c, const IR::Expression *dst) const;
+    const IR::Expression *lookup(const IR::Expression *e, const Facts &facts,
+                                 bool allowConst) const;
+    const IR::Constant *constantValue(const IR::Expression *e, const Facts &facts) const;
+    void define(const IR::Expression *dst, const IR::Expression *src, Facts &facts) const;
+    const IR::DpdkAsmStatement *foldBinary(const IR::DpdkBinaryStatement *s,
+                                           const Facts &facts) const;
+    /// Returns 1 if the jump is known to be taken, 0 if known not taken, -1 otherwise.
+    int jumpOutcome(const IR::DpdkJmpStatement *jmp, const Facts &facts) const;
+    /// Rewrites s using the facts holding before it and updates the facts.
+    /// Returns nullptr when s can be removed.
+    const IR::DpdkAsmStatement *simplify(const IR::DpdkAsmStatement *s, Facts &facts) const;
+    void transferLiveness(const IR::DpdkAsmStatement *s, Liveness &live) const;
+    bool isDeadStore(const IR::DpdkAsmStatement *s, const Liveness &live) const;
+
+    bool propagate(IR::IndexedVector<IR::DpdkAsmStatement> &stmts) const;
+    bool eliminateDeadStores(IR::IndexedVector<IR::DpdkAsmStatement> &stmts,
+                             const Liveness &exitLive) const;
+
+ public:
+    DataflowOptimization() { setName("DataflowOptimization"); }
+
+    const IR::Node *preorder(IR::DpdkAsmProgram *p) override;
+    const IR::Node *postorder(IR::DpdkAction *a) override;
+    const IR::Node *postorder(IR::DpdkListStatement *l) override;
+};
+
+}  // namespace DPDK
+#endif  /* BACKENDS_DPDK_DPDKASMDATAFLOW_H_ */
@@ -14,6 +14,9 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <algorithm>
+#include <map>
+#include <set>
 #include "dpdkAsmOpt.h"
 #include "dpdkUtils.h"
 
@@ -203,6 +206,167 @@ const IR::Node* RemoveUnusedMetadataFields::preorder(IR::DpdkAsmProgram *p) {
     return p;
 }
 
+// Returns the metadata field used as table key, or nullptr for keys from headers.
+static const IR::Member *metadataKeyField(const IR::Expression *e) {
+    auto mem = e->to<IR::Member>();
+    if (!mem)
+        return nullptr;
+    auto type = mem->expr->type;
+    if (type && type->is<IR::Type_Struct>() && isMetadataStruct(type->to<IR::Type_Struct>()))
+        return mem;
+    if (mem->expr->toString() == "m")
+        return mem;
+    return nullptr;
+}
+
+const IR::Node* PackMatchKeyFields::preorder(IR::DpdkAsmProgram *p) {
+    prune();
+    const IR::DpdkStructType *metaStruct = nullptr;
+    for (auto st : p->structType) {
+        if (isMetadataStruct(st)) {
+            metaStruct = st;
+            break;
+        }
+    }
+    if (!metaStruct)
+        return p;
+    auto &fields = metaStruct->fields;
+    const size_t n = fields.size();
+    std::vector<int> bits(n);
+    for (size_t i = 0; i < n; i++)
+        bits[i] = std::max(ValidateTableKeys::getFieldSizeBits(fields.at(i)->type), 0);
+
+    // glued[i] is set when field i must stay immediately before field i + 1:
+    // hash instructions take the range of fields between their first and last operand
+    // and learn instructions copy the action arguments from consecutive fields.
+    std::vector<bool> glued(n, false);
+    auto glue = [&](int first, int last) {
+        for (int i = first; i >= 0 && i < last && i + 1 < static_cast<int>(n); i++)
+            glued[i] = true;
+    };
+    std::map<cstring, int> argCount;
+    for (auto a : p->actions) {
+        if (a->para.parameters.size() != 1)
+            continue;
+        auto argType = a->para.parameters.at(0)->type->to<IR::Type_Name>();
+        if (!argType)
+            continue;
+        for (auto st : p->structType) {
+            if (st->name.name == argType->path->name.name)
+                argCount[a->name.name] = st->fields.size();
+        }
+    }
+    forAllMatching<IR::DpdkGetHashStatement>(p, [&](const IR::DpdkGetHashStatement *h) {
+        auto l = h->fields->to<IR::ListExpression>();
+        if (!l || l->components.empty())
+            return;
+        auto first = metadataKeyField(l->components.at(0));
+        auto last = metadataKeyField(l->components.at(l->components.size() - 1));
+        if (first && last)
+            glue(metaStruct->getFieldIndex(first->member.name),
+                 metaStruct->getFieldIndex(last->member.name));
+    });
+    forAllMatching<IR::DpdkLearnStatement>(p, [&](const IR::DpdkLearnStatement *l) {
+        auto arg = l->argument ? metadataKeyField(l->argument) : nullptr;
+        if (!arg)
+            return;
+        int first = metaStruct->getFieldIndex(arg->member.name);
+        auto count = argCount.find(l->action);
+        if (count != argCount.end())
+            glue(first, first + count->second - 1);
+        else
+            glue(first, static_cast<int>(n) - 1);
+    });
+
+    // Group the fields into atoms of glued fields, which are moved as a whole.
+    std::vector<unsigned> atomOf(n);
+    std::vector<std::vector<unsigned>> atoms;
+    for (size_t i = 0; i < n; i++) {
+        if (i == 0 || !glued[i - 1])
+            atoms.emplace_back();
+        atoms.back().push_back(i);
+        atomOf[i] = atoms.size() - 1;
+    }
+
+    struct KeyInfo {
+        std::set<unsigned> atoms;
+        int bits = 0;
+        int first = -1;
+        int last = -1;
+    };
+    std::vector<KeyInfo> keys;
+    auto addKey = [&](const IR::Key *key) {
+        if (!key)
+            return;
+        KeyInfo info;
+        for (auto k : key->keyElements) {
+            auto mem = metadataKeyField(k->expression);
+            if (!mem)
+                continue;
+            int idx = metaStruct->getFieldIndex(mem->member.name);
+            if (idx < 0)
+                continue;
+            int offset = metaStruct->getFieldBitOffset(mem->member.name);
+            info.atoms.insert(atomOf[idx]);
+            info.bits += bits[idx];
+            if (info.first == -1 || offset < info.first)
+                info.first = offset;
+            if (info.last == -1 || offset + bits[idx] > info.last)
+                info.last = offset + bits[idx];
+        }
+        if (info.atoms.empty())
+            return;
+        if (packAll || info.last - info.first > DPDK_TABLE_MAX_KEY_SIZE)
+            keys.push_back(info);
+    };
+    for (auto t : p->tables)
+        addKey(t->match_keys);
+    for (auto l : p->learners)
+        addKey(l->match_keys);
+    for (auto s : p->selectors)
+        addKey(s->selectors);
+    if (keys.empty())
+        return p;
+
+    // Lay out the keys first, largest keys first, and then the remaining fields in their
+    // original order.
+    std::stable_sort(keys.begin(), keys.end(), [](const KeyInfo &a, const KeyInfo &b) {
+        return a.bits > b.bits;
+    });
+    std::vector<bool> placed(atoms.size(), false);
+    IR::IndexedVector<IR::StructField> packed;
+    auto place = [&](unsigned atom) {
+        if (placed[atom])
+            return;
+        placed[atom] = true;
+        for (auto i : atoms[atom])
+            packed.push_back(fields.at(i));
+    };
+    for (auto &key : keys) {
+        for (auto atom : key.atoms)
+            place(atom);
+    }
+    for (unsigned atom = 0; atom < atoms.size(); atom++)
+        place(atom);
+
+    bool changed = false;
+    for (size_t i = 0; i < n; i++)
+        changed |= packed.at(i) != fields.at(i);
+    if (!changed)
+        return p;
+
+    IR::IndexedVector<IR::DpdkStructType> structs;
+    for (auto st : p->structType) {
+        if (st == metaStruct)
+            structs.push_back(new IR::DpdkStructType(st->srcInfo, st->name,
+                                                     st->annotations, packed));
+        else
+            structs.push_back(st);
+    }
+    p->structType = structs;
+    return p;
+}
+
 int ValidateTableKeys::getFieldSizeBits(const IR::Type *field_type) {
     if (auto t = field_type->to<IR::Type_Bits>()) {
         return t->width_bits();
@@ -228,38 +392,50 @@ bool ValidateTableKeys::preorder(const IR::DpdkAsmProgram *p) {
         }
     }
     for (auto tbl : p->tables) {
-        int min, max, size_max_field = 0;
         auto keys = tbl->match_keys;
-        if (!keys || keys->keyElements.size() == 0) {
-            return false;
-        }
-        min = max = -1;
+        if (!keys || keys->keyElements.size() == 0)
+            continue;
+        // Key data spans from the first to the last key field of each underlying structure
+        std::map<const IR::Type_StructLike *, std::pair<int, int>> span;
         for (auto key : keys->keyElements) {
             BUG_CHECK(key->expression->is<IR::Member>(), "Table keys must be a structure field. "
                                                           "%1% is not a structure field", key);
             auto keyMem = key->expression->to<IR::Member>();
             auto type = keyMem->expr->type;
+            const IR::Type_StructLike *st = nullptr;
             if (type->is<IR::Type_Struct>()
-                && isMetadataStruct(type->to<IR::Type_Struct>())) {
-                auto offset = metaStruct->getFieldBitOffset(keyMem->member.name);
-                if (min == -1 || min > offset)
-                    min = offset;
-                if (max == -1 || max < offset) {
-                    max = offset;
-                    auto field_type = key->expression->type;
-                    size_max_field = getFieldSizeBits(field_type);
-                    if (size_max_field == -1) {
-                        BUG("Unexpected type %1%", field_type->node_type_name());
-                        return false;
-                    }
-                 }
-             }
-            if ((max + size_max_field - min) > DPDK_TABLE_MAX_KEY_SIZE) {
+                && isMetadataStruct(type->to<IR::Type_Struct>()))
+                st = metaStruct;
+            else
+                st = type->to<IR::Type_StructLike>();
+            if (!st)
+                continue;
+            auto field_type = key->expression->type;
+            int size = getFieldSizeBits(field_type);
+            if (size == -1) {
+                BUG("Unexpected type %1%", field_type->node_type_name());
+                return false;
+            }
+            int offset = st->getFieldBitOffset(keyMem->member.name);
+            auto it = span.find(st);
+            if (it == span.end()) {
+                span.emplace(st, std::make_pair(offset, offset + size));
+            } else {
+                it->second.first = std::min(it->second.first, offset);
+                it->second.second = std::max(it->second.second, offset + size);
+            }
+        }
+        unsigned keySize = 0;
+        for (auto &s : span) {
+            int size = s.second.second - s.second.first;
+            if (s.first == metaStruct && size > DPDK_TABLE_MAX_KEY_SIZE) {
                 ::error(ErrorType::ERR_UNSUPPORTED_ON_TARGET, "%1%: All table keys together with"
                         " holes in the underlying structure should fit in 64 bytes", tbl->name);
                 return false;
             }
+            keySize += size;
         }
+        structure->table_key_size[tbl->name] = keySize;
     }
     return false;
 }
@@ -30,6 +30,8 @@ limitations under the License.
 #include "lib/gmputil.h"
 #include "lib/json.h"
 #include "dpdkUtils.h"
+#include "dpdkProgramStructure.h"
+#include "dpdkAsmDataflow.h"
 
 #define DPDK_TABLE_MAX_KEY_SIZE 64*8
 
@@ -164,13 +166,29 @@ class RemoveUnusedMetadataFields : public Transform {
     bool isByteSizeField(const IR::Type *field_type);
 };
 
+// This pass reorders the fields of the metadata struct so that the key fields of each table
+// are contiguous, which minimizes the size of the key data hashed and compared by the target
+// (the key spans all bytes from the first to the last key field, including holes).
+// Tables with larger keys are laid out first. Fields which must stay contiguous (hash input
+// ranges and learner action arguments) are moved together.
+// Unless packAll is set, only tables whose keys would not fit within 64 bytes are packed.
+class PackMatchKeyFields : public Transform {
+    bool packAll;
+
+ public:
+    explicit PackMatchKeyFields(bool packAll) : packAll(packAll) {}
+    const IR::Node* preorder(IR::DpdkAsmProgram *p) override;
+};
+
 // This pass validates that the table keys from Metadata struct fit within 64 bytes including any
-// holes between the key fields in metadata.
+// holes between the key fields in metadata, and records the resulting key size of each table.
 class ValidateTableKeys : public Inspector {
+    DpdkProgramStructure *structure;
+
  public:
-    ValidateTableKeys() {}
+    explicit ValidateTableKeys(DpdkProgramStructure *structure) : structure(structure) {}
     bool preorder(const IR::DpdkAsmProgram *p) override;
-    int getFieldSizeBits(const IR::Type *field_type);
+    static int getFieldSizeBits(const IR::Type *field_type);
 };
 
 // This pass shorten the Identifier length
@@ -570,10 +588,12 @@ class CopyPropagationAndElimination : public Transform {
 
 // Instructions can only appear in actions and apply block of .spec file.
 // All these individual passes work on the actions and apply block of .spec file.
+// When enableDataflowOpt is set, the CFG based DataflowOptimization also runs in
+// the loop, so that jumps it folds let the label passes clean up after it.
 class DpdkAsmOptimization : public PassRepeated {
  private:
  public:
-    DpdkAsmOptimization() {
+    explicit DpdkAsmOptimization(bool enableDataflowOpt = false) {
         passes.push_back(new RemoveRedundantLabel);
         auto r = new PassRepeated{new RemoveLabelAfterLabel};
         passes.push_back(r);
@@ -581,6 +601,8 @@ class DpdkAsmOptimization : public PassRepeated {
         passes.push_back(new RemoveRedundantLabel);
         passes.push_back(r);
         passes.push_back(new ThreadJumps);
+        if (enableDataflowOpt)
+            passes.push_back(new DataflowOptimization);
     }
 };
 
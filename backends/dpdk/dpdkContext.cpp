@@ -458,6 +458,9 @@ void DpdkContextGenerator::addMatchTables(Util::JsonArray* tablesJson) {
                         position++;
                     }
                     tableJson->emplace("match_key_fields", keyJson);
+                    auto keySize = structure->table_key_size.find(tbl->name.toString());
+                    if (keySize != structure->table_key_size.end())
+                        tableJson->emplace("match_key_size_bits", keySize->second);
                 }
             }
             // If table implementation is action profile or action selector, all actions from member
@@ -0,0 +1,249 @@
+/*
+Copyright 2022 Intel Corp.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <iomanip>
+#include <set>
+#include "dpdkCostReport.h"
+#include "dpdkAsmCfg.h"
+#include "dpdkUtils.h"
+#include "printUtils.h"
+
+namespace DPDK {
+
+static cstring formatAverage(double v) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2) << v;
+    return out.str();
+}
+
+double DpdkPathCost::avgInstructions() const {
+    if (paths == 0)
+        return 0;
+    return totalInstructions / static_cast<double>(paths);
+}
+
+double DpdkPathCost::avgLookups() const {
+    if (paths == 0)
+        return 0;
+    return totalLookups / static_cast<double>(paths);
+}
+
+// Averages are emitted as decimal strings, as JSON numbers are integers here.
+void DpdkPathCost::toJson(Util::JsonObject *json, bool withLookups) const {
+    json->emplace("paths", paths);
+    json->emplace("min_instructions", minInstructions);
+    json->emplace("max_instructions", maxInstructions);
+    json->emplace("avg_instructions", formatAverage(avgInstructions()));
+    if (!withLookups)
+        return;
+    json->emplace("min_table_lookups", minLookups);
+    json->emplace("max_table_lookups", maxLookups);
+    json->emplace("avg_table_lookups", formatAverage(avgLookups()));
+}
+
+// The compiler only produces forward jumps, so the blocks of the control flow
+// graph are in topological order and the costs of all paths starting at each
+// block can be computed in a single backward sweep.
+DpdkPathCost DpdkCostReport::pathCost(
+        const IR::IndexedVector<IR::DpdkAsmStatement> &stmts) const {
+    DpdkAsmCFG cfg(stmts);
+    std::vector<DpdkPathCost> from(cfg.blocks.size());
+    for (unsigned b = cfg.blocks.size(); b-- > 0;) {
+        auto &block = cfg.blocks[b];
+        unsigned minInstr = 0, maxInstr = 0, lookups = 0;
+        double meanInstr = 0;
+        for (size_t i = block.begin; i < block.end; i++) {
+            auto stmt = stmts.at(i);
+            if (stmt->is<IR::DpdkLabelStatement>())
+                continue;
+            minInstr++;
+            maxInstr++;
+            meanInstr++;
+            if (auto apply = stmt->to<IR::DpdkApplyStatement>()) {
+                lookups++;
+                auto it = tableCost.find(apply->table);
+                if (it != tableCost.end()) {
+                    minInstr += it->second.minInstructions;
+                    maxInstr += it->second.maxInstructions;
+                    meanInstr += it->second.avgInstructions();
+                }
+            }
+        }
+
+        std::vector<unsigned> succs;
+        if (block.taken >= 0)
+            succs.push_back(block.taken);
+        if (block.fallthrough >= 0 && block.fallthrough != block.taken)
+            succs.push_back(block.fallthrough);
+        auto &cost = from[b];
+        bool first = true;
+        auto merge = [&](const DpdkPathCost &next) {
+            cost.paths += next.paths;
+            cost.totalInstructions += next.totalInstructions;
+            cost.totalLookups += next.totalLookups;
+            if (first || next.minInstructions < cost.minInstructions)
+                cost.minInstructions = next.minInstructions;
+            if (first || next.maxInstructions > cost.maxInstructions)
+                cost.maxInstructions = next.maxInstructions;
+            if (first || next.minLookups < cost.minLookups)
+                cost.minLookups = next.minLookups;
+            if (first || next.maxLookups > cost.maxLookups)
+                cost.maxLookups = next.maxLookups;
+            first = false;
+        };
+        for (auto s : succs) {
+            BUG_CHECK(s > b, "%1%: unexpected backward jump", cfg.last(b));
+            merge(from[s]);
+        }
+        if (block.exit || succs.empty()) {
+            DpdkPathCost end;
+            end.paths = 1;
+            merge(end);
+        }
+        double paths = static_cast<double>(cost.paths);
+        cost.minInstructions += minInstr;
+        cost.maxInstructions += maxInstr;
+        cost.totalInstructions += meanInstr * paths;
+        cost.minLookups += lookups;
+        cost.maxLookups += lookups;
+        cost.totalLookups += lookups * paths;
+    }
+    if (from.empty()) {
+        DpdkPathCost empty;
+        empty.paths = 1;
+        return empty;
+    }
+    return from[0];
+}
+
+// A table lookup runs one of the actions of the table; each action is counted
+// as one path.
+DpdkPathCost DpdkCostReport::lookupCost(const IR::Expression *default_action,
+                                        const IR::ActionList *actions) const {
+    DpdkPathCost cost;
+    std::set<cstring> names;
+    if (actions) {
+        for (auto ale : actions->actionList)
+            names.insert(toStr(ale->expression));
+    }
+    if (default_action)
+        names.insert(toStr(default_action));
+    bool first = true;
+    for (auto name : names) {
+        unsigned min = 0, max = 0;
+        double mean = 0;
+        auto it = actionCost.find(name);
+        if (it != actionCost.end()) {
+            min = it->second.minInstructions;
+            max = it->second.maxInstructions;
+            mean = it->second.avgInstructions();
+        }
+        cost.paths += 1;
+        cost.totalInstructions += mean;
+        if (first || min < cost.minInstructions)
+            cost.minInstructions = min;
+        if (first || max > cost.maxInstructions)
+            cost.maxInstructions = max;
+        first = false;
+    }
+    return cost;
+}
+
+bool DpdkCostReport::preorder(const IR::DpdkAsmProgram *p) {
+    for (auto st : p->structType) {
+        if (!isMetadataStruct(st))
+            continue;
+        for (auto f : st->fields) {
+            unsigned bits = 8;  // bool and error are implemented as bit<8>
+            if (auto t = f->type->to<IR::Type_Bits>())
+                bits = t->width_bits();
+            metadataFieldBits.emplace(f->name.name, bits);
+        }
+    }
+
+    for (auto a : p->actions) {
+        auto cost = pathCost(a->statements);
+        // Every action ends with an implicit return.
+        cost.minInstructions++;
+        cost.maxInstructions++;
+        cost.totalInstructions += static_cast<double>(cost.paths);
+        actionCost.emplace(a->name.name, cost);
+    }
+    for (auto t : p->tables)
+        tableCost.emplace(t->name, lookupCost(t->default_action, t->actions));
+    for (auto l : p->learners)
+        tableCost.emplace(l->name, lookupCost(l->default_action, l->actions));
+    for (auto s : p->statements) {
+        if (auto l = s->to<IR::DpdkListStatement>())
+            applyCost = pathCost(l->statements);
+    }
+    return true;
+}
+
+bool DpdkCostReport::preorder(const IR::Member *m) {
+    // metadata struct field used like m.<field_name> in expressions
+    if (m->expr->toString() == "m") {
+        auto it = metadataFieldBits.find(m->member.name);
+        if (it != metadataFieldBits.end())
+            metadataTouched.emplace(m->member.name, it->second);
+    }
+    return false;
+}
+
+void DpdkCostReport::serializeCostReport(std::ostream &out) const {
+    auto json = new Util::JsonObject();
+    auto apply = new Util::JsonObject();
+    applyCost.toJson(apply, true);
+    json->emplace("apply", apply);
+
+    auto tables = new Util::JsonArray();
+    for (auto &t : tableCost) {
+        auto table = new Util::JsonObject();
+        table->emplace("name", t.first);
+        table->emplace("actions", t.second.paths);
+        table->emplace("min_action_instructions", t.second.minInstructions);
+        table->emplace("max_action_instructions", t.second.maxInstructions);
+        table->emplace("avg_action_instructions", formatAverage(t.second.avgInstructions()));
+        tables->append(table);
+    }
+    json->emplace("tables", tables);
+
+    auto actions = new Util::JsonArray();
+    for (auto &a : actionCost) {
+        auto action = new Util::JsonObject();
+        action->emplace("name", a.first);
+        a.second.toJson(action, false);
+        actions->append(action);
+    }
+    json->emplace("actions", actions);
+
+    unsigned bytes = 0;
+    auto fields = new Util::JsonArray();
+    for (auto &f : metadataTouched) {
+        bytes += (f.second + 7) / 8;
+        fields->append(f.first);
+    }
+    auto metadata = new Util::JsonObject();
+    metadata->emplace("fields_touched", static_cast<unsigned>(metadataTouched.size()));
+    metadata->emplace("bytes_touched", bytes);
+    metadata->emplace("fields", fields);
+    json->emplace("metadata", metadata);
+
+    json->serialize(out);
+    out << std::endl;
+}
+
+}  // namespace DPDK
@@ -0,0 +1,69 @@
+/*
+Copyright 2022 Intel Corp.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef BACKENDS_DPDK_DPDKCOSTREPORT_H_
+#define BACKENDS_DPDK_DPDKCOSTREPORT_H_
+
+#include "ir/ir.h"
+#include "lib/gmputil.h"
+#include "lib/json.h"
+#include "lib/ordered_map.h"
+
+namespace DPDK {
+
+/// Static cost of the paths through an instruction sequence.
+struct DpdkPathCost {
+    /// Number of distinct control flow paths.
+    big_int paths = 0;
+    unsigned minInstructions = 0;
+    unsigned maxInstructions = 0;
+    /// Sum over all paths of the instructions executed, where a table lookup
+    /// counts the mean cost of the actions of the table.
+    double totalInstructions = 0;
+    unsigned minLookups = 0;
+    unsigned maxLookups = 0;
+    double totalLookups = 0;
+
+    double avgInstructions() const;
+    double avgLookups() const;
+    void toJson(Util::JsonObject *json, bool withLookups) const;
+};
+
+/// This pass computes a static per-packet cost model of the final assembly
+/// program: the number of instructions and table lookups on the paths through
+/// the apply block (including the instructions of the actions run by each
+/// lookup), the cost of each action and table, and the metadata touched.
+/// The result is serialized as JSON by serializeCostReport().
+class DpdkCostReport : public Inspector {
+    ordered_map<cstring, DpdkPathCost> actionCost;
+    ordered_map<cstring, DpdkPathCost> tableCost;
+    DpdkPathCost applyCost;
+    ordered_map<cstring, unsigned> metadataFieldBits;
+    ordered_map<cstring, unsigned> metadataTouched;
+
+    DpdkPathCost pathCost(const IR::IndexedVector<IR::DpdkAsmStatement> &stmts) const;
+    DpdkPathCost lookupCost(const IR::Expression *default_action,
+                            const IR::ActionList *actions) const;
+
+ public:
+    DpdkCostReport() { setName("DpdkCostReport"); }
+    bool preorder(const IR::DpdkAsmProgram *p) override;
+    bool preorder(const IR::Member *m) override;
+    void serializeCostReport(std::ostream &out) const;
+};
+
+}  // namespace DPDK
+#endif  /* BACKENDS_DPDK_DPDKCOSTREPORT_H_ */
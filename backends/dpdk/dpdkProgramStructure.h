@@ -44,6 +44,9 @@ struct DpdkProgramStructure {
     std::map<cstring, std::vector<std::pair<cstring, cstring>>> key_map;
     std::map<cstring, const IR::P4Table *>                      group_tables;
     std::map<cstring, const IR::P4Table *>                      member_tables;
+    // Size in bits of the key data (including holes between the key fields) of each table,
+    // computed on the final assembly program
+    std::map<cstring, unsigned>                                 table_key_size;
 
     std::set<cstring> pipeline_controls;
     std::set<cstring> non_pipeline_controls;
@@ -30,10 +30,16 @@ class DpdkOptions : public CompilerOptions {
     cstring tdiFile = "";
     // file to ouput context Json to
     cstring ctxtFile = "";
+    // file to output the static instruction cost report to
+    cstring costReportFile = "";
     // read from json
     bool loadIRFromJson = false;
     // Enable/Disable Egress pipeline in psa
     bool enableEgress = false;
+    // Enable/Disable CFG based dataflow optimization of the generated assembly
+    bool enableDataflowOpt = false;
+    // Reorder metadata fields so that the key fields of every table are contiguous
+    bool enableKeyPacking = false;
 
     DpdkOptions() {
         registerOption(
@@ -52,6 +58,22 @@ class DpdkOptions : public CompilerOptions {
                 return true;
             },
             "[Dpdk back-end] Enable egress pipeline's codegen\n", OptionFlags::Hide);
+        registerOption(
+            "--enableDataflowOpt", nullptr,
+            [this](const char *) {
+                enableDataflowOpt = true;
+                return true;
+            },
+            "[Dpdk back-end] Enable global copy propagation, constant folding and dead code\n"
+            "elimination across jumps in the generated assembly\n");
+        registerOption(
+            "--enableKeyPacking", nullptr,
+            [this](const char *) {
+                enableKeyPacking = true;
+                return true;
+            },
+            "[Dpdk back-end] Lay out the metadata fields used as table keys contiguously,\n"
+            "largest keys first, to minimize the key size of every table\n");
 
         registerOption("--bf-rt-schema", "file",
                 [this](const char *arg) { bfRtSchema = arg; return true; },
@@ -65,6 +87,10 @@ class DpdkOptions : public CompilerOptions {
         registerOption("--context", "file",
                 [this](const char *arg) { ctxtFile = arg; return true; },
                 "Generate and write context JSON to the specified file");
+        registerOption("--cost-report", "file",
+                [this](const char *arg) { costReportFile = arg; return true; },
+                "Write per-path instruction and table lookup counts of the generated\n"
+                "spec as JSON to the specified file");
         registerOption("--fromJSON", "file",
                 [this](const char* arg) { loadIRFromJson = true; file = arg; return true; },
                 "Use IR representation from JsonFile dumped previously,"\
@@ -29,6 +29,7 @@ import shutil
 import difflib
 import subprocess
 import glob
+import json
 
 SUCCESS = 0
 FAILURE = 1
@@ -47,6 +48,8 @@ class Options(object):
         self.runDebugger_skip = 0
         self.generateP4Runtime = False
         self.generateBfRt = False
+        self.generateCostReport = False
+        self.generateContext = False
 
 def usage(options):
     name = options.binary
@@ -61,6 +64,8 @@ def usage(options):
     print("          -a \"args\": pass args to the compiler")
     print("          --p4runtime: generate P4Info message in text format")
     print("          --bfrt: generate BfRt message in text format")
+    print("          --cost-report: generate the static cost report of the spec")
+    print("          --context: generate the context JSON")
 
 def isError(p4filename):
     # True if the filename represents a p4 program that should fail
@@ -211,6 +216,16 @@ def check_generated_files(options, tmpdir, expecteddir):
                     return FAILURE
     return SUCCESS
 
+def normalize_context(contextFile):
+    # Drop the fields which depend on when and where the compiler ran
+    with open(contextFile) as f:
+        context = json.load(f)
+    for field in ["build_date", "compile_command", "compiler_version"]:
+        context.pop(field, None)
+    with open(contextFile, "w") as f:
+        json.dump(context, f, indent=4)
+        f.write("\n")
+
 def file_name(tmpfolder, base, suffix, ext):
     return os.path.join(tmpfolder, base + "-" + suffix + ext)
 
@@ -241,6 +256,8 @@ def process_file(options, argv):
     p4runtimeFile = os.path.join(tmpdir, basename + ".p4info.txt")
     p4runtimeEntriesFile = os.path.join(tmpdir, basename + ".entries.txt")
     bfRtSchemaFile = os.path.join(tmpdir, basename + ".bfrt.json")
+    costReportFile = os.path.join(tmpdir, basename + ".cost.json")
+    contextFile = os.path.join(tmpdir, basename + ".context.json")
     def getArch(path):
         v1Pattern = re.compile('include.*v1model\.p4')
         pnaPattern = re.compile('include.*pna\.p4')
@@ -269,6 +286,10 @@ def process_file(options, argv):
             args.extend(["--p4runtime-entries-files", p4runtimeEntriesFile])
         if options.generateBfRt:
             args.extend(["--bf-rt-schema", bfRtSchemaFile])
+    if options.generateCostReport:
+        args.extend(["--cost-report", costReportFile])
+    if options.generateContext:
+        args.extend(["--context", contextFile])
 
     if "p4_14" in options.p4filename or "v1_samples" in options.p4filename:
         args.extend(["--std", "p4-14"])
@@ -294,6 +315,8 @@ def process_file(options, argv):
         result = FAILURE
 
     if result == SUCCESS:
+        if options.generateContext and os.path.isfile(contextFile):
+            normalize_context(contextFile)
         result = check_generated_files(options, tmpdir, expected_dirname)
 
     if options.cleanupTmp:
@@ -352,6 +375,10 @@ def main(argv):
             options.generateP4Runtime = True
         elif argv[0] == "--bfrt":
             options.generateBfRt = True
+        elif argv[0] == "--cost-report":
+            options.generateCostReport = True
+        elif argv[0] == "--context":
+            options.generateContext = True
         else:
             print("Unknown option ", argv[0], file=sys.stderr)
             usage(options)
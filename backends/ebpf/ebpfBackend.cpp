@@ -38,6 +38,8 @@ void emitFilterModel(const EbpfOptions& options, Target* target, const IR::Tople
     auto ebpfprog = new EBPFProgram(options, toplevel->getProgram(), refMap, typeMap, toplevel);
     if (!ebpfprog->build())
         return;
+    if (options.insnBudget != 0)
+        ebpfprog->estimateComplexity();
 
     if (options.outputFile.isNullOrEmpty())
         return;
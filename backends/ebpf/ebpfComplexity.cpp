@@ -0,0 +1,425 @@
+/*
+Copyright 2026 The P4 Language Consortium
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <functional>
+
+#include "ebpfComplexity.h"
+#include "ebpfType.h"
+#include "lib/algorithm.h"
+#include "lib/error.h"
+#include "lib/log.h"
+#include "frontends/p4/coreLibrary.h"
+#include "frontends/p4/methodInstance.h"
+
+namespace EBPF {
+
+namespace {
+
+// Approximate number of eBPF instructions emitted for common constructs.
+const unsigned ProgramOverhead = 40;    // prologue, metadata and return code handling
+const unsigned BlockOverhead = 10;      // entering a parser or a control
+const unsigned HelperCall = 8;          // loading the arguments and calling a helper
+const unsigned MapLookup = 6;           // bpf_map_lookup_elem() and the NULL check
+const unsigned BoundsCheck = 5;         // comparing the packet offset to the packet end
+const unsigned FieldCopy = 5;           // load, shift/mask, byte swap and store of a field
+const unsigned Branch = 2;              // compare and jump
+
+// Maximum size of the stack of an eBPF program (MAX_BPF_STACK).
+const unsigned MaxStackSize = 512;
+
+}  // namespace
+
+// Adds up the cost of the nodes of an expression; method calls are
+// resolved by the ProgramComplexity instance.
+class ExpressionCost : public Inspector {
+    ProgramComplexity* owner;
+
+ public:
+    ProgramComplexity::Cost cost;
+
+    explicit ExpressionCost(ProgramComplexity* owner) : owner(owner) {
+        setName("ExpressionCost");
+    }
+
+    bool preorder(const IR::MethodCallExpression* expression) override {
+        cost += owner->methodCall(expression);
+        return false;
+    }
+    bool preorder(const IR::Expression* expression) override {
+        cost.add(owner->words(expression));
+        return true;
+    }
+};
+
+unsigned ProgramComplexity::widthInBits(const IR::Type* type) const {
+    auto ebpfType = EBPFTypeFactory::instance->create(type);
+    if (ebpfType != nullptr && ebpfType->is<IHasWidth>())
+        return ebpfType->to<IHasWidth>()->implementationWidthInBits();
+    return 64;
+}
+
+// Number of 64-bit registers needed to hold the value of an expression.
+unsigned ProgramComplexity::words(const IR::Expression* expression) const {
+    auto type = typeMap->getType(expression);
+    if (type != nullptr) {
+        if (auto tb = type->to<IR::Type_Bits>())
+            return std::max(1u, static_cast<unsigned>(ROUNDUP(tb->width_bits(), 64)));
+    }
+    return 1;
+}
+
+void ProgramComplexity::declare(const IR::Declaration_Variable* decl) {
+    stackBytes += ROUNDUP(widthInBits(decl->type), 64) * 8;
+}
+
+void ProgramComplexity::addLoop(const IR::Node* node, unsigned bound) {
+    // a loop is reached through all the paths leading to it
+    for (auto loop : loops) {
+        if (loop.node == node)
+            return;
+    }
+    loops.push_back({node, bound});
+}
+
+ProgramComplexity::Cost ProgramComplexity::expression(const IR::Expression* expression) {
+    ExpressionCost visitor(this);
+    expression->apply(visitor);
+    return visitor.cost;
+}
+
+ProgramComplexity::Cost ProgramComplexity::headerAccess(const IR::Expression* header) {
+    Cost cost;
+    auto type = typeMap->getType(header);
+    if (type == nullptr || !type->is<IR::Type_Header>()) {
+        cost.add(HelperCall);
+        return cost;
+    }
+    auto ht = type->to<IR::Type_Header>();
+    cost.add(BoundsCheck + FieldCopy * ht->fields.size() + Branch);
+    return cost;
+}
+
+ProgramComplexity::Cost ProgramComplexity::tableApply(const IR::P4Table* table) {
+    Cost cost;
+    unsigned keyBytes = 0;
+    bool ternary = false;
+    auto key = table->getKey();
+    if (key != nullptr) {
+        for (auto ke : key->keyElements) {
+            cost += expression(ke->expression);
+            cost.add(1);  // store to the key structure
+            keyBytes += ROUNDUP(widthInBits(typeMap->getType(ke->expression)), 8);
+            if (ke->matchType->path->name.name == corelib.ternaryMatch.name)
+                ternary = true;
+        }
+    }
+    keyBytes = ROUNDUP(keyBytes, 8) * 8;
+    // key structure and the pointer to the value
+    unsigned scratch = keyBytes + 8;
+    // lookup of the entry and, on a miss, of the default action
+    cost.add(2 * MapLookup + Branch);
+
+    if (ternary) {
+        // The tuple space search iterates over the masks of the table; each
+        // iteration masks the key 8 bytes at a time and looks it up in a tuple.
+        Cost iteration;
+        iteration.add(2 * MapLookup + 2 * Branch + 4 * (keyBytes / 8) + 4);
+        iteration.repeat(options.maxTernaryMasks);
+        cost += iteration;
+        addLoop(table, options.maxTernaryMasks);
+        // masked key and the current and next masks
+        scratch += 3 * keyBytes;
+    }
+    scratchStackBytes = std::max(scratchStackBytes, scratch);
+
+    Cost actions;
+    for (auto a : table->getActionList()->actionList) {
+        auto adecl = refMap->getDeclaration(a->getPath(), true);
+        auto action = adecl->getNode()->to<IR::P4Action>();
+        if (action == nullptr)
+            continue;
+        actions.add(Branch);  // case of the switch on the action id
+        actions.branch(statement(action->body));
+    }
+    cost += actions;
+    return cost;
+}
+
+ProgramComplexity::Cost ProgramComplexity::methodCall(const IR::MethodCallExpression* expression) {
+    Cost cost;
+    auto mi = P4::MethodInstance::resolve(expression, refMap, typeMap);
+    if (auto apply = mi->to<P4::ApplyMethod>()) {
+        if (apply->isTableApply())
+            cost += tableApply(apply->object->to<IR::P4Table>());
+        return cost;
+    }
+    if (auto action = mi->to<P4::ActionCall>()) {
+        for (auto arg : *expression->arguments)
+            cost += this->expression(arg->expression);
+        cost += statement(action->action->body);
+        return cost;
+    }
+    if (mi->is<P4::BuiltInMethod>()) {
+        // isValid(), setValid() and setInvalid() access the valid flag
+        cost.add(Branch);
+        return cost;
+    }
+    if (auto em = mi->to<P4::ExternMethod>()) {
+        if (em->method->name.name == corelib.packetIn.extract.name ||
+            em->method->name.name == corelib.packetOut.emit.name) {
+            if (!expression->arguments->empty())
+                return headerAccess(expression->arguments->at(0)->expression);
+        }
+    }
+    for (auto arg : *expression->arguments)
+        cost += this->expression(arg->expression);
+    cost.add(HelperCall);
+    return cost;
+}
+
+ProgramComplexity::Cost ProgramComplexity::statement(const IR::StatOrDecl* statement) {
+    Cost cost;
+    if (statement == nullptr)
+        return cost;
+
+    if (auto block = statement->to<IR::BlockStatement>()) {
+        for (auto component : block->components)
+            cost += this->statement(component);
+    } else if (auto decl = statement->to<IR::Declaration_Variable>()) {
+        declare(decl);
+        if (decl->initializer != nullptr) {
+            cost += expression(decl->initializer);
+            cost.add(1);
+        }
+    } else if (auto assign = statement->to<IR::AssignmentStatement>()) {
+        cost += expression(assign->right);
+        cost.add(words(assign->left));
+    } else if (auto call = statement->to<IR::MethodCallStatement>()) {
+        cost += methodCall(call->methodCall);
+    } else if (auto ifs = statement->to<IR::IfStatement>()) {
+        cost += expression(ifs->condition);
+        cost.add(Branch);
+        Cost branches = this->statement(ifs->ifTrue);
+        branches.branch(this->statement(ifs->ifFalse));
+        cost += branches;
+    } else if (auto sw = statement->to<IR::SwitchStatement>()) {
+        cost += expression(sw->expression);
+        Cost cases;
+        for (auto c : sw->cases) {
+            cases.add(Branch);
+            cases.branch(this->statement(c->statement));
+        }
+        cost += cases;
+    } else if (statement->is<IR::ExitStatement>() || statement->is<IR::ReturnStatement>()) {
+        cost.add(1);
+    }
+    return cost;
+}
+
+ProgramComplexity::Cost ProgramComplexity::parserState(const IR::ParserState* state) {
+    Cost cost;
+    cost.add(Branch);
+    for (auto component : state->components)
+        cost += statement(component);
+    if (auto select = state->selectExpression->to<IR::SelectExpression>()) {
+        cost += expression(select->select);
+        for (auto c : select->selectCases)
+            cost.add(Branch * words(c->keyset) + 1);
+    } else if (state->selectExpression != nullptr) {
+        cost.add(1);
+    }
+    return cost;
+}
+
+void ProgramComplexity::addParser(const EBPFParser* parser) {
+    auto container = parser->parserBlock->container;
+    for (auto decl : container->parserLocals) {
+        if (auto var = decl->to<IR::Declaration_Variable>())
+            declare(var);
+    }
+
+    std::map<cstring, const IR::ParserState*> states;
+    for (auto state : container->states)
+        states.emplace(state->name.name, state);
+
+    // Bound of a loop of the parser: the size of the header stack that
+    // it extracts to, as extracting past the end of the stack rejects the packet.
+    auto stackBound = [this](const IR::ParserState* state) {
+        unsigned bound = 0;
+        for (auto component : state->components) {
+            auto call = component->to<IR::MethodCallStatement>();
+            if (call == nullptr || call->methodCall->arguments->empty())
+                continue;
+            auto member = call->methodCall->arguments->at(0)->expression->to<IR::Member>();
+            if (member == nullptr || member->member.name != IR::Type_Stack::next)
+                continue;
+            auto type = typeMap->getType(member->expr);
+            auto stack = type != nullptr ? type->to<IR::Type_Stack>() : nullptr;
+            if (stack != nullptr && stack->sizeKnown())
+                bound = std::max(bound, static_cast<unsigned>(stack->getSize()));
+        }
+        return bound;
+    };
+
+    // Longest path from each state to the end of the parser. When a state
+    // transitions back to a state on the current path, the cycle is a loop
+    // whose body is counted once per iteration.
+    std::map<cstring, Cost> fromState;
+    std::vector<const IR::ParserState*> path;
+    std::function<Cost(cstring)> visit = [&](cstring name) -> Cost {
+        Cost cost;
+        auto it = states.find(name);
+        if (it == states.end() || name == IR::ParserState::accept ||
+            name == IR::ParserState::reject)
+            return cost;
+        auto state = it->second;
+        auto onPath = std::find(path.begin(), path.end(), state);
+        if (onPath != path.end()) {
+            unsigned bound = 0;
+            Cost body;
+            for (auto s = onPath; s != path.end(); ++s) {
+                bound = std::max(bound, stackBound(*s));
+                body += parserState(*s);
+            }
+            addLoop(state, bound);
+            if (bound > 1) {
+                body.repeat(bound - 1);
+                cost += body;
+            }
+            return cost;
+        }
+        auto known = fromState.find(name);
+        if (known != fromState.end())
+            return known->second;
+
+        path.push_back(state);
+        Cost next;
+        if (auto select = state->selectExpression->to<IR::SelectExpression>()) {
+            for (auto c : select->selectCases)
+                next.branch(visit(c->state->path->name.name));
+        } else if (auto target = state->selectExpression->to<IR::PathExpression>()) {
+            next = visit(target->path->name.name);
+        }
+        path.pop_back();
+
+        cost = parserState(state);
+        cost += next;
+        fromState.emplace(name, cost);
+        return cost;
+    };
+
+    total.add(BlockOverhead);
+    total += visit(IR::ParserState::start);
+}
+
+void ProgramComplexity::addControl(const EBPFControl* control) {
+    auto container = control->controlBlock->container;
+    for (auto decl : container->controlLocals) {
+        if (auto var = decl->to<IR::Declaration_Variable>())
+            declare(var);
+    }
+
+    total.add(BlockOverhead);
+    for (auto component : container->body->components) {
+        total += statement(component);
+        if (splitPoint == nullptr && options.insnBudget != 0 &&
+            total.explored > options.insnBudget / 2)
+            splitPoint = component;
+    }
+}
+
+bool ProgramComplexity::appliesTable(const IR::StatOrDecl* statement) const {
+    bool found = false;
+    forAllMatching<IR::MethodCallExpression>(statement,
+                                             [&](const IR::MethodCallExpression* expression) {
+        auto mi = P4::MethodInstance::resolve(expression, refMap, typeMap);
+        if (auto apply = mi->to<P4::ApplyMethod>())
+            found = found || apply->isTableApply();
+    });
+    return found;
+}
+
+std::vector<size_t> ProgramComplexity::splitControl(const EBPFControl* control,
+                                                    unsigned budget) {
+    auto container = control->controlBlock->container;
+    for (auto decl : container->controlLocals) {
+        if (auto var = decl->to<IR::Declaration_Variable>())
+            declare(var);
+    }
+
+    // The first stage also runs the parser accounted for so far; the next ones
+    // restore their state from a map and from the headers stored in the CPU map.
+    std::vector<size_t> starts = { 0 };
+    Cost stage = total;
+    stage.add(ProgramOverhead + BlockOverhead);
+    total.add(BlockOverhead);
+    auto& components = container->body->components;
+    for (size_t i = 0; i < components.size(); i++) {
+        Cost cost = statement(components.at(i));
+        if (i > starts.back() && stage.explored + cost.explored > budget &&
+            appliesTable(components.at(i))) {
+            starts.push_back(i);
+            stage = Cost();
+            stage.add(ProgramOverhead + BlockOverhead + 2 * MapLookup + HelperCall);
+        }
+        stage += cost;
+        total += cost;
+    }
+    return starts;
+}
+
+void ProgramComplexity::check(cstring name) const {
+    Cost cost = total;
+    cost.add(ProgramOverhead);
+    unsigned stack = stackBytes + scratchStackBytes;
+    LOG1("Estimated size of eBPF program " << name << ": "
+         << cost.path << " instructions on the longest path, "
+         << cost.explored << " instructions to verify, "
+         << stack << " bytes of stack, "
+         << loops.size() << " loops");
+
+    for (auto loop : loops) {
+        if (loop.bound == 0) {
+            ::warning(ErrorType::WARN_OVERFLOW,
+                      "%1%: parser loop of %2% is not bounded by a header stack; "
+                      "the verifier has to walk through every iteration of it",
+                      loop.node, name);
+        }
+    }
+    if (stack > MaxStackSize) {
+        ::warning(ErrorType::WARN_OVERFLOW,
+                  "%1%: program may use %2% bytes of stack, more than the %3% bytes "
+                  "allowed by the verifier; consider smaller table keys or local variables",
+                  name, stack, MaxStackSize);
+    }
+    if (cost.explored > options.insnBudget) {
+        if (splitPoint != nullptr) {
+            ::warning(ErrorType::WARN_OVERFLOW,
+                      "%1%: program %2% is estimated to need %3% instructions to be verified, "
+                      "more than the budget of %4%; consider moving the processing "
+                      "starting here to a separate program called with a tail call",
+                      splitPoint, name, cost.explored, options.insnBudget);
+        } else {
+            ::warning(ErrorType::WARN_OVERFLOW,
+                      "%1%: program is estimated to need %2% instructions to be verified, "
+                      "more than the budget of %3%; consider splitting it with tail calls",
+                      name, cost.explored, options.insnBudget);
+        }
+    }
+}
+
+}  // namespace EBPF
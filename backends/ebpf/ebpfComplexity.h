@@ -0,0 +1,114 @@
+/*
+Copyright 2026 The P4 Language Consortium
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _BACKENDS_EBPF_EBPFCOMPLEXITY_H_
+#define _BACKENDS_EBPF_EBPFCOMPLEXITY_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "ebpfObject.h"
+#include "ebpfOptions.h"
+#include "ebpfParser.h"
+#include "ebpfControl.h"
+
+namespace EBPF {
+
+/*
+ * Estimates the size of the eBPF program generated for a parser and a set of
+ * controls, so that programs likely to be rejected by the verifier are reported
+ * at compile time (--insn-budget). The numbers are computed from the IR with a
+ * coarse cost model of the code emitted by this back-end; they are meant to
+ * compare program versions, not to predict the exact verifier log.
+ */
+class ProgramComplexity {
+ public:
+    struct Cost {
+        // instructions on the longest path through the code
+        unsigned path = 0;
+        // instructions the verifier walks through at least once,
+        // loop bodies being counted once per iteration
+        unsigned explored = 0;
+
+        void add(unsigned insns) { path += insns; explored += insns; }
+        Cost& operator+=(const Cost& other) {
+            path += other.path; explored += other.explored; return *this; }
+        // Accounts for 'other' as an alternative to the code already counted.
+        void branch(const Cost& other) {
+            path = std::max(path, other.path); explored += other.explored; }
+        void repeat(unsigned times) { path *= times; explored *= times; }
+    };
+
+ protected:
+    struct Loop {
+        const IR::Node* node;
+        unsigned bound;  // 0 if unknown
+    };
+
+    const EbpfOptions& options;
+    P4::ReferenceMap*  refMap;
+    P4::TypeMap*       typeMap;
+    P4::P4CoreLibrary& corelib;
+
+    Cost total;
+    // stack used by variables live during the whole program
+    unsigned stackBytes = 0;
+    // largest stack used by a temporary scope (e.g. the key of a table lookup)
+    unsigned scratchStackBytes = 0;
+    std::vector<Loop> loops;
+    // first top-level statement of a control after which the program
+    // exceeds half of the budget; a good place to split it with a tail call
+    const IR::Node* splitPoint = nullptr;
+
+    unsigned widthInBits(const IR::Type* type) const;
+    unsigned words(const IR::Expression* expression) const;
+
+    Cost expression(const IR::Expression* expression);
+    Cost methodCall(const IR::MethodCallExpression* expression);
+    Cost headerAccess(const IR::Expression* header);
+    Cost tableApply(const IR::P4Table* table);
+    Cost statement(const IR::StatOrDecl* statement);
+    Cost parserState(const IR::ParserState* state);
+    void declare(const IR::Declaration_Variable* decl);
+    void addLoop(const IR::Node* node, unsigned bound);
+    bool appliesTable(const IR::StatOrDecl* statement) const;
+
+    friend class ExpressionCost;
+
+ public:
+    ProgramComplexity(const EbpfOptions& options, P4::ReferenceMap* refMap,
+                      P4::TypeMap* typeMap) :
+            options(options), refMap(refMap), typeMap(typeMap),
+            corelib(P4::P4CoreLibrary::instance) {}
+
+    void addParser(const EBPFParser* parser);
+    void addControl(const EBPFControl* control);
+    // Accounts for data that the generated program keeps on the stack (e.g. headers).
+    void addStack(unsigned bytes) { stackBytes += bytes; }
+
+    // Accounts for 'control' split into stages chained with tail calls, each
+    // estimated to need at most 'budget' instructions to be verified; a stage
+    // only starts at a top-level statement applying a table. Returns the index
+    // in the control body of the first statement of each stage.
+    std::vector<size_t> splitControl(const EBPFControl* control, unsigned budget);
+
+    // Prints the estimates of program 'name' and warns if they exceed the limits.
+    void check(cstring name) const;
+};
+
+}  // namespace EBPF
+
+#endif /* _BACKENDS_EBPF_EBPFCOMPLEXITY_H_ */
@@ -597,15 +597,30 @@ void EBPFControl::emitDeclaration(CodeBuilder* builder, const IR::Declaration* d
 }
 
 void EBPFControl::emit(CodeBuilder* builder) {
+    emitDeclarations(builder);
+    emitBody(builder, 0, controlBlock->container->body->components.size());
+}
+
+void EBPFControl::emitDeclarations(CodeBuilder* builder) {
     auto hitType = EBPFTypeFactory::instance->create(IR::Type_Boolean::get());
     builder->emitIndent();
     hitType->declare(builder, hitVariable, false);
     builder->endOfStatement(true);
     for (auto a : controlBlock->container->controlLocals)
         emitDeclaration(builder, a);
+}
+
+void EBPFControl::emitBody(CodeBuilder* builder, size_t first, size_t last) {
+    auto body = controlBlock->container->body;
+    if (first != 0 || last != body->components.size()) {
+        IR::IndexedVector<IR::StatOrDecl> components;
+        for (size_t i = first; i < last; i++)
+            components.push_back(body->components.at(i));
+        body = new IR::BlockStatement(body->srcInfo, components);
+    }
     builder->emitIndent();
     codeGen->setBuilder(builder);
-    controlBlock->container->body->apply(*codeGen);
+    body->apply(*codeGen);
     builder->newline();
 }
 
@@ -628,4 +643,9 @@ void EBPFControl::emitTableInitializers(CodeBuilder* builder) {
         it.second->emitInitializer(builder);
 }
 
+void EBPFControl::emitTableBatchFunctions(CodeBuilder* builder) {
+    for (auto it : tables)
+        it.second->emitBatchFunctions(builder);
+}
+
 }  // namespace EBPF
@@ -73,9 +73,14 @@ class EBPFControl : public EBPFObject {
     EBPFControl(const EBPFProgram* program, const IR::ControlBlock* block,
                 const IR::Parameter* parserHeaders);
     virtual void emit(CodeBuilder* builder);
+    // Declares the variables used by the control body.
+    virtual void emitDeclarations(CodeBuilder* builder);
+    // Emits the statements [first, last) of the control body.
+    void emitBody(CodeBuilder* builder, size_t first, size_t last);
     virtual void emitDeclaration(CodeBuilder* builder, const IR::Declaration* decl);
     virtual void emitTableTypes(CodeBuilder* builder);
     virtual void emitTableInitializers(CodeBuilder* builder);
+    void emitTableBatchFunctions(CodeBuilder* builder);
     virtual void emitTableInstances(CodeBuilder* builder);
     virtual bool build();
     EBPFTable* getTable(cstring name) const {
@@ -39,9 +39,18 @@ EbpfOptions::EbpfOptions() {
         registerOption("--emit-externs", nullptr,
                 [this](const char*) { emitExterns = true; return true; },
                 "[ebpf back-end] Allow for user-provided implementation of extern functions.");
+        registerOption("--emit-table-batch-api", nullptr,
+                [this](const char*) { emitTableBatchAPI = true; return true; },
+                "[ebpf back-end] Generate control-plane functions adding, modifying and"
+                " deleting entries of each table in batches.");
         registerOption("--trace", nullptr,
                 [this](const char*) { emitTraceMessages = true; return true; },
                 "Generate tracing messages of packet processing");
+        registerOption("--optimize-parser", nullptr,
+                [this](const char*) { optimizeParser = true; return true; },
+                "[ebpf back-end] Check the packet length once for consecutive extracts"
+                " in a parser state and compile select expressions on constants to"
+                " switch statements");
         registerOption("--max-ternary-masks", "MAX_TERNARY_MASKS",
                 [this](const char *arg) {
                    unsigned int parsed_val = std::strtoul(arg, nullptr, 0);
@@ -50,6 +59,72 @@ EbpfOptions::EbpfOptions() {
                    return true;
                 }, "Set number of maximum possible masks for a ternary key"
                   " in a single table");
+        registerOption("--table-caching", nullptr,
+                [this](const char*) { enableTableCache = true; return true; },
+                "[psa only] Cache the results of ternary table lookups in an LRU map"
+                " consulted before the tuple space search; the control plane must increment"
+                " <TBL-NAME>_cache_generation after each modification of the table");
+        registerOption("--ternary-priority-order", nullptr,
+                [this](const char*) { orderTernaryMasks = true; return true; },
+                "[psa only] Expect the masks of ternary tables to be chained by decreasing"
+                " priority of their entries and stop the tuple space search as soon as"
+                " no remaining mask can give a better match");
+        registerOption("--table-array-map-width", "WIDTH",
+                [this](const char *arg) {
+                   unsigned int parsed_val = std::strtoul(arg, nullptr, 0);
+                   if (parsed_val > 16) {
+                       ::error(ErrorType::ERR_INVALID,
+                               "--table-array-map-width: at most 16 bits are supported");
+                       return false;
+                   }
+                   this->arrayTableMaxKeyWidth = parsed_val;
+                   return true;
+                }, "[psa only] Back exact-match tables keyed by a single field of at most"
+                   " WIDTH bits (up to 16) with an array map indexed by the key"
+                   " (0 disables it, the default)");
+        registerOption("--inline-const-entries", "N",
+                [this](const char *arg) {
+                   this->inlineConstEntriesMax = std::strtoul(arg, nullptr, 0);
+                   return true;
+                }, "[psa only] Match the const entries of tables with at most N entries"
+                   " (and no direct externs) in generated code instead of BPF maps"
+                   " (0 disables it, the default)");
+        registerOption("--per-cpu-meter-batch", "N",
+                [this](const char *arg) {
+                   unsigned int parsed_val = std::strtoul(arg, nullptr, 0);
+                   if (parsed_val == 0) {
+                       ::error(ErrorType::ERR_INVALID,
+                               "--per-cpu-meter-batch: at least 1 packet is required");
+                       return false;
+                   }
+                   this->perCpuMeterBatch = parsed_val;
+                   return true;
+                }, "[psa only] Number of packets worth of tokens that a @per_cpu Meter"
+                   " borrows at once from its shared token bucket (default 16)");
+        registerOption("--insn-budget", "INSNS",
+                [this](const char *arg) {
+                   this->insnBudget = std::strtoul(arg, nullptr, 0);
+                   return true;
+                }, "[ebpf back-end] Estimate the instructions, loops and stack of each"
+                   " generated eBPF program and warn when the verifier may have to walk"
+                   " through more than INSNS instructions (0 disables it, the default)");
+        registerOption("--max-stage-insns", "INSNS",
+                [this](const char *arg) {
+                   this->maxStageInsns = std::strtoul(arg, nullptr, 0);
+                   return true;
+                }, "[psa only] Split the TC ingress and egress controls at table applies"
+                   " into programs chained with tail calls, each estimated to need at most"
+                   " INSNS instructions (0 disables it, the default)");
+        registerOption("--xdp", nullptr,
+                [this](const char*) { generateToXDP = true; return true; },
+                "[psa only] Compile the PSA ingress and egress pipelines to XDP programs;"
+                " packets that are cloned or multicast are handed over to TC");
+        registerOption("--burst", "N",
+                [this](const char *arg) {
+                   this->burstSize = std::strtoul(arg, nullptr, 0);
+                   return true;
+                }, "[ubpf only] Also generate a process_burst() entry point processing"
+                   " up to N packets per call (0 disables it, the default)");
         registerOption("--xdp2tc", "MODE",
                 [this](const char* arg) {
                    if (!strcmp(arg, "meta")) {
@@ -35,17 +35,39 @@ class EbpfOptions : public CompilerOptions {
     bool loadIRFromJson = false;
     // Externs generation
     bool emitExterns = false;
+    // control-plane functions updating table entries in batches
+    bool emitTableBatchAPI = false;
     // tracing eBPF code execution
     bool emitTraceMessages = false;
+    // hoist parser bounds checks and compile select on constants to switch statements
+    bool optimizeParser = false;
     // XDP2TC mode for PSA-eBPF
     enum XDP2TC xdp2tcMode = XDP2TC_NONE;
     // maximum number of unique ternary masks
     unsigned int maxTernaryMasks = 128;
+    // cache results of ternary table lookups in PSA-eBPF
+    bool enableTableCache = false;
+    // ternary masks are chained by decreasing priority of their entries
+    bool orderTernaryMasks = false;
+    // widest single-field exact key of a PSA table backed by an array map (0 disables)
+    unsigned int arrayTableMaxKeyWidth = 0;
+    // largest number of const entries of a PSA table matched by inline code (0 disables)
+    unsigned int inlineConstEntriesMax = 0;
+    // packets worth of tokens borrowed at once by a per-CPU meter
+    unsigned int perCpuMeterBatch = 16;
+    // compile the PSA pipelines to the XDP hook
+    bool generateToXDP = false;
+    // estimated instructions to verify above which a program is reported (0 disables)
+    unsigned int insnBudget = 0;
+    // estimated instructions of a PSA control stage chained with tail calls (0 disables)
+    unsigned int maxStageInsns = 0;
+    // maximum number of packets handed to the generated process_burst() (uBPF)
+    unsigned int burstSize = 0;
 
     EbpfOptions();
 
     void calculateXDP2TCMode() {
-        if (arch != "psa") {
+        if (arch != "psa" || generateToXDP) {
             return;
         }
 
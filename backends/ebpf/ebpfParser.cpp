@@ -14,6 +14,8 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <algorithm>
+
 #include "ebpfModel.h"
 #include "ebpfParser.h"
 #include "ebpfType.h"
@@ -158,6 +160,9 @@ bool StateTranslationVisitor::preorder(const IR::ParserState* parserState) {
     builder->target->emitTraceMessage(builder, msgStr.c_str(), 1,
                                       state->parser->program->offsetVar);
 
+    if (state->parser->program->options.optimizeParser)
+        hoistLengthChecks(parserState);
+
     visit(parserState->components, "components");
     if (parserState->selectExpression == nullptr) {
         builder->emitIndent();
@@ -212,6 +217,9 @@ bool StateTranslationVisitor::preorder(const IR::SelectExpression* expression) {
         }
     }
 
+    if (state->parser->program->options.optimizeParser && emitSelectSwitch(expression))
+        return false;
+
     for (auto e : expression->selectCases)
         visit(e);
 
@@ -221,6 +229,116 @@ bool StateTranslationVisitor::preorder(const IR::SelectExpression* expression) {
     return false;
 }
 
+/**
+ * A select whose cases are all constants (the default case is a mask with all bits
+ * cleared) is compiled to a switch statement, which clang turns into a binary search
+ * instead of a chain of comparisons. Returns false if the select is not suitable.
+ */
+bool StateTranslationVisitor::emitSelectSwitch(const IR::SelectExpression* expression) {
+    auto type = state->parser->program->typeMap->getType(expression->select, true);
+    if (auto list = type->to<IR::Type_List>())
+        type = list->components.at(0);
+    auto bits = type->to<IR::Type_Bits>();
+    if (bits == nullptr || !EBPFScalarType::generatesScalar(bits->width_bits()))
+        return false;
+
+    std::vector<const IR::SelectCase*> cases;
+    const IR::SelectCase* defaultCase = nullptr;
+    for (auto e : expression->selectCases) {
+        if (auto mask = e->keyset->to<IR::Mask>()) {
+            auto right = mask->right->to<IR::Constant>();
+            if (right == nullptr || !right->value.is_zero())
+                return false;
+            defaultCase = e;
+            break;
+        }
+        if (!e->keyset->is<IR::Constant>())
+            return false;
+        cases.push_back(e);
+    }
+
+    builder->emitIndent();
+    builder->appendFormat("switch (%s) ", selectValue.c_str());
+    builder->blockStart();
+    std::set<big_int> seen;
+    for (auto e : cases) {
+        // the first case wins, a duplicate label would not compile
+        auto value = e->keyset->to<IR::Constant>();
+        if (!seen.insert(value->value).second)
+            continue;
+        builder->emitIndent();
+        builder->append("case ");
+        visit(value);
+        builder->append(": goto ");
+        visit(e->state);
+        builder->endOfStatement(true);
+    }
+    builder->emitIndent();
+    builder->append("default: goto ");
+    if (defaultCase != nullptr)
+        visit(defaultCase->state);
+    else
+        builder->append(IR::ParserState::reject);
+    builder->endOfStatement(true);
+    builder->blockEnd(true);
+    return true;
+}
+
+/// Returns the header extracted by a fixed-size packet.extract() statement, or nullptr.
+const IR::Expression*
+StateTranslationVisitor::extractDestination(const IR::StatOrDecl* component) const {
+    auto stat = component->to<IR::MethodCallStatement>();
+    if (stat == nullptr)
+        return nullptr;
+    auto mi = P4::MethodInstance::resolve(stat->methodCall,
+                                          state->parser->program->refMap,
+                                          state->parser->program->typeMap);
+    auto extMethod = mi->to<P4::ExternMethod>();
+    if (extMethod == nullptr || extMethod->object != state->parser->packet ||
+        extMethod->method->name.name != p4lib.packetIn.extract.name ||
+        stat->methodCall->arguments->size() != 1)
+        return nullptr;
+    auto destination = stat->methodCall->arguments->at(0)->expression;
+    if (!state->parser->typeMap->getType(destination)->is<IR::Type_StructLike>())
+        return nullptr;
+    return destination;
+}
+
+/**
+ * Finds the runs of consecutive extracts in a parser state, so that the packet length is
+ * checked once for each run. Note that a packet too short for any header of a run is
+ * rejected before the first header of the run is extracted.
+ */
+void StateTranslationVisitor::hoistLengthChecks(const IR::ParserState* parserState) {
+    hoistedChecks.clear();
+    uncheckedExtracts.clear();
+    std::vector<const IR::Expression*> run;
+    auto hoist = [this, &run]() {
+        if (run.size() > 1) {
+            unsigned offset = 0, checked = 0;
+            for (auto destination : run) {
+                auto ht = state->parser->typeMap->getType(destination)
+                                                ->to<IR::Type_StructLike>();
+                unsigned width = ht->width_bits();
+                checked = std::max(checked, offset + width + extractPadding(ht));
+                offset += width;
+                if (destination != run.front())
+                    uncheckedExtracts.insert(destination);
+            }
+            hoistedChecks.emplace(run.front(), checked);
+        }
+        run.clear();
+    };
+
+    for (auto component : parserState->components) {
+        if (auto destination = extractDestination(component))
+            run.push_back(destination);
+        else
+            hoist();
+    }
+    hoist();
+}
+
 bool StateTranslationVisitor::preorder(const IR::SelectCase* selectCase) {
     builder->emitIndent();
     if (auto pe = selectCase->keyset->to<IR::PathExpression>()) {
@@ -369,6 +487,32 @@ StateTranslationVisitor::compileExtractField(
     builder->newline();
 }
 
+// to load some fields the compiler will use larger words
+// than actual width of a field (e.g. 48-bit field loaded using load_dword())
+// we must ensure that the larger word is not outside of packet buffer.
+// FIXME: this can fail if a packet does not contain additional payload after header.
+//  However, we don't have better solution in case of using load_X functions to parse packet.
+// TODO: consider using a collection of smaller widths.
+unsigned StateTranslationVisitor::extractPadding(const IR::Type_StructLike* ht) const {
+    unsigned curr_padding = 0;
+    for (auto f : ht->fields) {
+        auto ftype = state->parser->typeMap->getType(f);
+        auto etype = EBPFTypeFactory::instance->create(ftype);
+        if (etype->is<EBPFScalarType>()) {
+            auto scalarType = etype->to<EBPFScalarType>();
+            unsigned readWordSize = scalarType->alignment() * 8;
+            unsigned unaligned = scalarType->widthInBits() % readWordSize;
+            unsigned padding = readWordSize - unaligned;
+            if (padding == readWordSize)
+                padding = 0;
+            if (scalarType->widthInBits() + padding >= curr_padding) {
+                curr_padding = padding;
+            }
+        }
+    }
+    return curr_padding;
+}
+
 void
 StateTranslationVisitor::compileExtract(const IR::Expression* destination) {
     cstring msgStr;
@@ -386,50 +530,38 @@ StateTranslationVisitor::compileExtract(const IR::Expression* destination) {
     cstring offsetStr = Util::printf_format("BYTES(%s + %s)",
                                             program->offsetVar, cstring::to_cstring(width));
 
-    builder->target->emitTraceMessage(builder, "Parser: check pkt_len=%d >= last_read_byte=%d",
-                                      2, program->lengthVar.c_str(), offsetStr.c_str());
+    if (uncheckedExtracts.count(destination) == 0) {
+        builder->target->emitTraceMessage(builder,
+                                          "Parser: check pkt_len=%d >= last_read_byte=%d",
+                                          2, program->lengthVar.c_str(), offsetStr.c_str());
 
-    // to load some fields the compiler will use larger words
-    // than actual width of a field (e.g. 48-bit field loaded using load_dword())
-    // we must ensure that the larger word is not outside of packet buffer.
-    // FIXME: this can fail if a packet does not contain additional payload after header.
-    //  However, we don't have better solution in case of using load_X functions to parse packet.
-    // TODO: consider using a collection of smaller widths.
-    unsigned curr_padding = 0;
-    for (auto f : ht->fields) {
-        auto ftype = state->parser->typeMap->getType(f);
-        auto etype = EBPFTypeFactory::instance->create(ftype);
-        if (etype->is<EBPFScalarType>()) {
-            auto scalarType = etype->to<EBPFScalarType>();
-            unsigned readWordSize = scalarType->alignment() * 8;
-            unsigned unaligned = scalarType->widthInBits() % readWordSize;
-            unsigned padding = readWordSize - unaligned;
-            if (padding == readWordSize)
-                padding = 0;
-            if (scalarType->widthInBits() + padding >= curr_padding) {
-                curr_padding = padding;
-            }
+        builder->emitIndent();
+        auto hoisted = hoistedChecks.find(destination);
+        if (hoisted != hoistedChecks.end()) {
+            builder->appendFormat("if (%s < %s + BYTES(%s + %u)) ",
+                                  program->packetEndVar.c_str(),
+                                  program->packetStartVar.c_str(),
+                                  program->offsetVar.c_str(), hoisted->second);
+        } else {
+            builder->appendFormat("if (%s < %s + BYTES(%s + %d + %u)) ",
+                                  program->packetEndVar.c_str(),
+                                  program->packetStartVar.c_str(),
+                                  program->offsetVar.c_str(), width, extractPadding(ht));
         }
-    }
+        builder->blockStart();
 
-    builder->emitIndent();
-    builder->appendFormat("if (%s < %s + BYTES(%s + %d + %u)) ",
-                          program->packetEndVar.c_str(),
-                          program->packetStartVar.c_str(),
-                          program->offsetVar.c_str(), width, curr_padding);
-    builder->blockStart();
+        builder->target->emitTraceMessage(builder, "Parser: invalid packet (packet too short)");
 
-    builder->target->emitTraceMessage(builder, "Parser: invalid packet (packet too short)");
-
-    builder->emitIndent();
-    builder->appendFormat("%s = %s;", program->errorVar.c_str(),
-                          p4lib.packetTooShort.str());
-    builder->newline();
+        builder->emitIndent();
+        builder->appendFormat("%s = %s;", program->errorVar.c_str(),
+                              p4lib.packetTooShort.str());
+        builder->newline();
 
-    builder->emitIndent();
-    builder->appendFormat("goto %s;", IR::ParserState::reject.c_str());
-    builder->newline();
-    builder->blockEnd(true);
+        builder->emitIndent();
+        builder->appendFormat("goto %s;", IR::ParserState::reject.c_str());
+        builder->newline();
+        builder->blockEnd(true);
+    }
 
     msgStr = Util::printf_format("Parser: extracting header %s", destination->toString());
     builder->target->emitTraceMessage(builder, msgStr.c_str());
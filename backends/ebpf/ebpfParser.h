@@ -36,6 +36,17 @@ class StateTranslationVisitor : public CodeGenInspector {
     P4::P4CoreLibrary& p4lib;
     const EBPFParserState* state;
 
+    // With --optimize-parser, the first extract of a run of consecutive extracts in
+    // a state checks the packet length for the whole run (number of bits to check),
+    // and the other extracts of the run are not checked.
+    std::map<const IR::Expression*, unsigned> hoistedChecks;
+    std::set<const IR::Expression*> uncheckedExtracts;
+
+    unsigned extractPadding(const IR::Type_StructLike* ht) const;
+    const IR::Expression* extractDestination(const IR::StatOrDecl* component) const;
+    void hoistLengthChecks(const IR::ParserState* parserState);
+    bool emitSelectSwitch(const IR::SelectExpression* expression);
+
     void compileExtractField(const IR::Expression* expr, cstring name,
                              unsigned alignment, EBPFType* type);
     virtual void compileExtract(const IR::Expression* destination);
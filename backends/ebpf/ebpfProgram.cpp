@@ -18,12 +18,14 @@ limitations under the License.
 #include <ctime>
 
 #include "ebpfProgram.h"
+#include "ebpfComplexity.h"
 #include "ebpfType.h"
 #include "ebpfControl.h"
 #include "ebpfParser.h"
 #include "ebpfTable.h"
 #include "frontends/p4/coreLibrary.h"
 #include "frontends/common/options.h"
+#include "lib/algorithm.h"
 
 namespace EBPF {
 
@@ -58,6 +60,18 @@ bool EBPFProgram::build() {
     return true;
 }
 
+void EBPFProgram::estimateComplexity() const {
+    ProgramComplexity complexity(options, refMap, typeMap);
+    // the headers are declared on the stack, see emitHeaderInstances()
+    if (parser->headerType->is<IHasWidth>()) {
+        auto width = parser->headerType->to<IHasWidth>()->implementationWidthInBits();
+        complexity.addStack(ROUNDUP(width, 8));
+    }
+    complexity.addParser(parser);
+    complexity.addControl(control);
+    complexity.check(functionName);
+}
+
 void EBPFProgram::emitC(CodeBuilder* builder, cstring header) {
     emitGeneratedComment(builder);
 
@@ -148,6 +162,8 @@ void EBPFProgram::emitH(CodeBuilder* builder, cstring) {
     builder->newline();
     control->emitTableInitializers(builder);
     builder->blockEnd(true);
+    if (options.emitTableBatchAPI)
+        control->emitTableBatchFunctions(builder);
     builder->appendLine("#endif");
     builder->appendLine("#endif");
 }
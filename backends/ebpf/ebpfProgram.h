@@ -83,6 +83,8 @@ class EBPFProgram : public EBPFObject {
     virtual void emitGeneratedComment(CodeBuilder* builder);
     virtual void emitH(CodeBuilder* builder, cstring headerFile);  // emits C headers
     virtual void emitC(CodeBuilder* builder, cstring headerFile);  // emits C program
+    // Reports the estimated size of the program (--insn-budget).
+    virtual void estimateComplexity() const;
 };
 
 }  // namespace EBPF
@@ -151,6 +151,21 @@ void EBPFTable::validateKeys() const {
     }
 }
 
+unsigned int EBPFTable::keyStructAlignment() const {
+    unsigned int structAlignment = 4;  // 4 by default
+    if (keyGenerator == nullptr)
+        return structAlignment;
+    for (auto c : keyGenerator->keyElements) {
+        auto it = keyTypes.find(c);
+        if (it == keyTypes.end())
+            continue;  // selector fields are not part of the key
+        auto scalar = it->second->to<EBPFScalarType>();
+        if (scalar != nullptr && scalar->alignment() > structAlignment)
+            structAlignment = 8;
+    }
+    return structAlignment;
+}
+
 void EBPFTable::emitKeyType(CodeBuilder* builder) {
     builder->emitIndent();
     builder->appendFormat("struct %s ", keyTypeName.c_str());
@@ -159,7 +174,7 @@ void EBPFTable::emitKeyType(CodeBuilder* builder) {
     CodeGenInspector commentGen(program->refMap, program->typeMap);
     commentGen.setBuilder(builder);
 
-    unsigned int structAlignment = 4;  // 4 by default
+    unsigned int structAlignment = keyStructAlignment();
     if (keyGenerator != nullptr) {
         if (isLPMTable()) {
             // For LPM kind key we need an additional 32 bit field - prefixlen
@@ -190,11 +205,6 @@ void EBPFTable::emitKeyType(CodeBuilder* builder) {
             auto ebpfType = ::get(keyTypes, c);
             cstring fieldName = ::get(keyFieldNames, c);
 
-            if (ebpfType->is<EBPFScalarType>() &&
-                ebpfType->to<EBPFScalarType>()->alignment() > structAlignment) {
-                structAlignment = 8;
-            }
-
             builder->emitIndent();
             ebpfType->declare(builder, fieldName, false);
 
@@ -284,6 +294,12 @@ void EBPFTable::emitValueType(CodeBuilder* builder) {
         builder->newline();
         builder->emitIndent();
         builder->appendLine("__u8 has_next;");
+        if (program->options.orderTernaryMasks) {
+            // highest priority of the entries in this tuple, chained in decreasing order;
+            // 0 if not maintained by the control plane
+            builder->emitIndent();
+            builder->appendLine("__u32 max_priority;");
+        }
         builder->blockEnd(false);
         builder->endOfStatement(true);
     }
@@ -749,6 +765,53 @@ void EBPFTable::emitInitializer(CodeBuilder* builder) {
     builder->blockEnd(true);
 }
 
+/**
+ * Emits control-plane functions adding, modifying and deleting an array of entries
+ * of the table at once. The file descriptor of the map is opened on first use.
+ */
+void EBPFTable::emitBatchFunctions(CodeBuilder* builder) {
+    cstring fd = dataMapName + "_fd";
+    cstring keyType = "struct " + keyTypeName;
+    cstring valueType = "struct " + valueTypeName;
+
+    builder->appendFormat("static int %s = -1;", fd.c_str());
+    builder->newline();
+
+    auto emitFunction = [&](cstring suffix, cstring flags) {
+        builder->appendFormat("static int %s_%s_entries(%s *keys, ",
+                              dataMapName.c_str(), suffix.c_str(), keyType.c_str());
+        if (!flags.isNullOrEmpty())
+            builder->appendFormat("%s *values, ", valueType.c_str());
+        builder->append("u32 *count) ");
+        builder->blockStart();
+        builder->emitIndent();
+        builder->appendFormat("if (%s < 0)", fd.c_str());
+        builder->newline();
+        builder->increaseIndent();
+        builder->emitIndent();
+        builder->appendFormat("%s = BPF_OBJ_GET(MAP_PATH \"/%s\")",
+                              fd.c_str(), dataMapName.c_str());
+        builder->endOfStatement(true);
+        builder->decreaseIndent();
+        builder->emitIndent();
+        builder->appendFormat("if (%s < 0) { *count = 0; return -1; }", fd.c_str());
+        builder->newline();
+        builder->emitIndent();
+        builder->append("return ");
+        if (flags.isNullOrEmpty())
+            builder->target->emitUserTableDeleteBatch(builder, fd, "keys", "count");
+        else
+            builder->target->emitUserTableUpdateBatch(builder, fd, "keys", "values",
+                                                      "count", flags);
+        builder->newline();
+        builder->blockEnd(true);
+    };
+
+    emitFunction("add", "BPF_NOEXIST");
+    emitFunction("modify", "BPF_EXIST");
+    emitFunction("delete", nullptr);
+}
+
 void EBPFTable::emitLookup(CodeBuilder* builder, cstring key, cstring value) {
     if (!isTernaryTable()) {
         builder->target->emitTableLookup(builder, dataMapName, key, value);
@@ -786,27 +849,46 @@ void EBPFTable::emitLookup(CodeBuilder* builder, cstring key, cstring value) {
     builder->emitIndent();
     builder->appendLine("break;");
     builder->blockEnd(true);
+    if (program->options.orderTernaryMasks) {
+        // Masks are ordered by decreasing max_priority, so no entry in this
+        // or any following tuple can win over the current best match.
+        // A max_priority of 0 is not known and never stops the search.
+        builder->emitIndent();
+        builder->appendFormat("if (%s != NULL && v->max_priority != 0 && "
+                              "v->max_priority <= %s->priority) ", value, value);
+        builder->blockStart();
+        builder->target->emitTraceMessage(builder,
+              "Control: No remaining mask can match with a higher priority");
+        builder->emitIndent();
+        builder->appendLine("break;");
+        builder->blockEnd(true);
+    }
     builder->emitIndent();
     cstring new_key = "k";
     builder->appendFormat("struct %s %s = {};", keyTypeName, new_key);
     builder->newline();
     builder->emitIndent();
-    builder->appendFormat("__u32 *chunk = ((__u32 *) &%s);", new_key);
+    // Mask the key 8 bytes at a time when the key structure is 8-byte aligned.
+    unsigned int chunkSize = keyStructAlignment();
+    cstring chunkType = chunkSize == 8 ? "__u64" : "__u32";
+    builder->appendFormat("%s *chunk = ((%s *) &%s);", chunkType, chunkType, new_key);
     builder->newline();
     builder->emitIndent();
-    builder->appendLine("__u32 *mask = ((__u32 *) &next);");
+    builder->appendFormat("%s *mask = ((%s *) &next);", chunkType, chunkType);
+    builder->newline();
     builder->emitIndent();
     builder->appendLine("#pragma clang loop unroll(disable)");
     builder->emitIndent();
-    builder->appendFormat("for (int i = 0; i < sizeof(struct %s_mask) / 4; i++) ", keyTypeName);
+    builder->appendFormat("for (int i = 0; i < sizeof(struct %s_mask) / %u; i++) ",
+                          keyTypeName, chunkSize);
     builder->blockStart();
-    cstring str = Util::printf_format("*(((__u32 *) &%s) + i)", key);
-    builder->target->emitTraceMessage(builder,
-                                  "Control: [Ternary] Masking next 4 bytes of %llx with mask %llx",
-                                  2, str, "mask[i]");
+    cstring str = Util::printf_format("*(((%s *) &%s) + i)", chunkType, key);
+    cstring traceMsg = Util::printf_format(
+            "Control: [Ternary] Masking next %u bytes of %%llx with mask %%llx", chunkSize);
+    builder->target->emitTraceMessage(builder, traceMsg.c_str(), 2, str, "mask[i]");
 
     builder->emitIndent();
-    builder->appendFormat("chunk[i] = ((__u32 *) &%s)[i] & mask[i];", key);
+    builder->appendFormat("chunk[i] = ((%s *) &%s)[i] & mask[i];", chunkType, key);
     builder->newline();
     builder->blockEnd(true);
 
@@ -74,6 +74,8 @@ class EBPFTable : public EBPFTableBase {
 
     bool isLPMTable() const;
     bool isTernaryTable() const;
+    // Alignment of the key structure: 8 if any key field needs it, 4 otherwise.
+    unsigned int keyStructAlignment() const;
 
     void emitTernaryInstance(CodeBuilder* builder);
 
@@ -111,6 +113,7 @@ class EBPFTable : public EBPFTableBase {
     virtual void emitDirectValueTypes(CodeBuilder* builder) { (void) builder; }
     virtual void emitAction(CodeBuilder* builder, cstring valueName, cstring actionRunVariable);
     virtual void emitInitializer(CodeBuilder* builder);
+    void emitBatchFunctions(CodeBuilder* builder);
     virtual void emitLookup(CodeBuilder* builder, cstring key, cstring value);
     virtual void emitLookupDefault(CodeBuilder* builder, cstring key, cstring value,
                                    cstring actionRunVariable) {
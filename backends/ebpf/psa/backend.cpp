@@ -76,6 +76,8 @@ void PSASwitchBackend::convert(const IR::ToplevelBlock *tlb) {
     program = program->apply(toEBPF);
 
     ebpf_program = convertToEbpfPSA->getPSAArchForEBPF();
+    if (ebpf_program != nullptr && options.insnBudget != 0)
+        ebpf_program->estimateComplexity();
 }
 
 }  // namespace EBPF
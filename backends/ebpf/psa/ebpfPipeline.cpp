@@ -15,6 +15,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 #include "ebpfPipeline.h"
+#include "backends/ebpf/ebpfComplexity.h"
 #include "backends/ebpf/ebpfParser.h"
 
 namespace EBPF {
@@ -47,6 +48,15 @@ bool EBPFPipeline::isEmpty() const {
     return true;
 }
 
+void EBPFPipeline::estimateComplexity() const {
+    // headers and metadata live in a per-CPU map, so they are not counted on the stack
+    ProgramComplexity complexity(options, refMap, typeMap);
+    complexity.addParser(parser);
+    complexity.addControl(control);
+    complexity.addControl(deparser);
+    complexity.check(name);
+}
+
 void EBPFPipeline::emitLocalVariables(CodeBuilder* builder) {
     builder->emitIndent();
     builder->appendFormat("unsigned %s = 0;", offsetVar.c_str());
@@ -168,6 +178,251 @@ void EBPFPipeline::emitTimestamp(CodeBuilder *builder) {
     builder->appendFormat("bpf_ktime_get_ns()");
 }
 
+void EBPFPipeline::splitIntoStages() {
+    auto container = control->controlBlock->container;
+    cstring reason;
+    if (!control->hashes.empty())
+        reason = "Hash externs keep their state in local variables";
+    for (auto decl : container->controlLocals) {
+        if (decl->is<IR::Declaration_Variable>() &&
+            control->codeGen->isPointerVariable(decl->name.name))
+            reason = "local variables cannot be pointers";
+    }
+    forAllMatching<IR::Member>(container, [&](const IR::Member* member) {
+        if (member->member.name == "resubmit")
+            reason = "a resubmitted packet has to go through the whole pipeline";
+    });
+    if (!reason.isNullOrEmpty()) {
+        ::warning(ErrorType::WARN_UNSUPPORTED,
+                  "%1%: cannot split the control of %2% into tail-called stages: %3%",
+                  container, name, reason);
+        return;
+    }
+
+    ProgramComplexity complexity(options, refMap, typeMap);
+    complexity.addParser(parser);
+    stageStarts = complexity.splitControl(control, options.maxStageInsns);
+    if (isSplit())
+        LOG1("Splitting the control of " << name << " into " << stageStarts.size() << " stages");
+}
+
+cstring EBPFPipeline::stageFunctionName(size_t stage) const {
+    return Util::printf_format("%s_stage%u", stagePrefix(), static_cast<unsigned>(stage));
+}
+
+void EBPFPipeline::emitStageTypes(CodeBuilder *builder) {
+    if (!isSplit())
+        return;
+    builder->appendFormat("struct %s_stage_state ", stagePrefix());
+    builder->blockStart();
+    builder->emitIndent();
+    builder->appendFormat("unsigned %s", offsetVar.c_str());
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->appendFormat("%s %s", errorEnum.c_str(), errorVar.c_str());
+    builder->endOfStatement(true);
+    emitStageStateFields(builder);
+    builder->blockEnd(false);
+    builder->endOfStatement(true);
+    builder->newline();
+}
+
+void EBPFPipeline::emitStageStateFields(CodeBuilder *builder) {
+    for (auto param : { control->inputStandardMetadata, control->outputStandardMetadata }) {
+        auto type = EBPFTypeFactory::instance->create(typeMap->getType(param));
+        builder->emitIndent();
+        type->declare(builder, param->name.name, false);
+        builder->endOfStatement(true);
+    }
+    for (auto decl : control->controlBlock->container->controlLocals) {
+        if (auto var = decl->to<IR::Declaration_Variable>()) {
+            auto type = EBPFTypeFactory::instance->create(var->type);
+            builder->emitIndent();
+            type->declare(builder, var->name.name, false);
+            builder->endOfStatement(true);
+        }
+    }
+}
+
+void EBPFPipeline::emitStageInstances(CodeBuilder *builder) {
+    if (!isSplit())
+        return;
+    builder->target->emitTableDecl(builder, stagePrefix() + "_stage_state_map",
+                                   TablePerCPUArray, "u32",
+                                   "struct " + stagePrefix() + "_stage_state", 1);
+    // the first stage is the program attached to the hook
+    std::vector<cstring> programs = { cstring::empty };
+    for (size_t stage = 1; stage < stageStarts.size(); stage++)
+        programs.push_back(stageFunctionName(stage));
+    builder->target->emitProgArrayDecl(builder, stagePrefix() + "_stages", programs);
+}
+
+void EBPFPipeline::emitStageStateLookup(CodeBuilder *builder) {
+    builder->emitIndent();
+    builder->appendFormat("struct %s_stage_state *", stagePrefix());
+    builder->target->emitTableLookup(builder, stagePrefix() + "_stage_state_map",
+                                     zeroKey, stageStateVar());
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->appendFormat("if (!%s)", stageStateVar());
+    builder->newline();
+    builder->emitIndent();
+    builder->emitIndent();
+    builder->appendFormat("return %s;", dropReturnCode());
+    builder->newline();
+}
+
+void EBPFPipeline::emitStageLocals(CodeBuilder *builder, bool save) {
+    for (auto decl : control->controlBlock->container->controlLocals) {
+        if (!decl->is<IR::Declaration_Variable>())
+            continue;
+        cstring local = decl->name.name;
+        cstring stored = Util::printf_format("%s->%s", stageStateVar(), local);
+        builder->emitIndent();
+        builder->appendFormat("__builtin_memcpy(&%s, &%s, sizeof(%s));",
+                              save ? stored : local, save ? local : stored, local);
+        builder->newline();
+    }
+}
+
+void EBPFPipeline::emitStageMetadataFromState(CodeBuilder *builder) {
+    for (auto param : { control->inputStandardMetadata, control->outputStandardMetadata }) {
+        auto type = EBPFTypeFactory::instance->create(typeMap->getType(param));
+        bool isPointer = control->codeGen->isPointerVariable(param->name.name);
+        builder->emitIndent();
+        type->declare(builder, param->name.name, isPointer);
+        builder->appendFormat(" = %s%s->%s", isPointer ? "&" : "",
+                              stageStateVar(), param->name.name);
+        builder->endOfStatement(true);
+    }
+}
+
+void EBPFPipeline::emitControlStage(CodeBuilder *builder, size_t stage) {
+    auto& components = control->controlBlock->container->body->components;
+    size_t first = stageStarts.at(stage);
+    bool last = stage + 1 == stageStarts.size();
+    control->emitDeclarations(builder);
+    if (stage != 0)
+        emitStageLocals(builder, false);
+    control->emitBody(builder, first, last ? components.size() : stageStarts.at(stage + 1));
+    if (last)
+        return;
+
+    // pass the state of the control to the next stage
+    builder->emitIndent();
+    builder->blockStart();
+    if (stage == 0)
+        emitStageStateLookup(builder);
+    for (auto var : { offsetVar, errorVar }) {
+        builder->emitIndent();
+        builder->appendFormat("%s->%s = %s;", stageStateVar(), var, var);
+        builder->newline();
+    }
+    for (auto param : { control->inputStandardMetadata, control->outputStandardMetadata }) {
+        bool isPointer = control->codeGen->isPointerVariable(param->name.name);
+        builder->emitIndent();
+        builder->appendFormat("%s->%s = %s%s;", stageStateVar(), param->name.name,
+                              isPointer ? "*" : "", param->name.name);
+        builder->newline();
+    }
+    emitStageLocals(builder, true);
+    cstring msgStr = Util::printf_format("%s control: tail call to stage %d", sectionName,
+                                         static_cast<unsigned>(stage + 1));
+    builder->target->emitTraceMessage(builder, msgStr.c_str());
+    builder->emitIndent();
+    builder->target->emitTailCall(builder, contextVar, stagePrefix() + "_stages",
+                                  static_cast<unsigned>(stage + 1));
+    builder->newline();
+    msgStr = Util::printf_format("%s control: tail call failed, dropping packet", sectionName);
+    builder->target->emitTraceMessage(builder, msgStr.c_str());
+    builder->emitIndent();
+    builder->appendFormat("return %s;", dropReturnCode());
+    builder->newline();
+    builder->blockEnd(true);
+}
+
+void EBPFPipeline::emitStageFunctions(CodeBuilder *builder) {
+    cstring msgStr;
+    for (size_t stage = 1; stage < stageStarts.size(); stage++) {
+        builder->newline();
+        builder->target->emitCodeSection(builder, Util::printf_format("%s-stage%u",
+                                         sectionName, static_cast<unsigned>(stage)));
+        builder->emitIndent();
+        builder->target->emitMain(builder, stageFunctionName(stage), model.CPacketName.str());
+        builder->spc();
+        builder->blockStart();
+
+        // the global metadata has been initialized by the first stage
+        EBPFPipeline::emitGlobalMetadataInitializer(builder);
+        emitLocalVariables(builder);
+        emitUserMetadataInstance(builder);
+        emitHeaderInstances(builder);
+        builder->newline();
+        emitCPUMAPLookup(builder);
+        builder->emitIndent();
+        builder->append("if (!hdrMd)");
+        builder->newline();
+        builder->emitIndent();
+        builder->emitIndent();
+        builder->appendFormat("return %s;", dropReturnCode());
+        builder->newline();
+        emitHeadersFromCPUMAP(builder);
+        builder->newline();
+        emitMetadataFromCPUMAP(builder);
+        builder->newline();
+
+        emitStageStateLookup(builder);
+        for (auto var : { offsetVar, errorVar }) {
+            builder->emitIndent();
+            builder->appendFormat("%s = %s->%s;", var, stageStateVar(), var);
+            builder->newline();
+        }
+        emitStageMetadataFromState(builder);
+        builder->newline();
+
+        msgStr = Util::printf_format("%s control: stage %d started", sectionName,
+                                     static_cast<unsigned>(stage));
+        builder->target->emitTraceMessage(builder, msgStr.c_str());
+        builder->emitIndent();
+        builder->blockStart();
+        emitControlStage(builder, stage);
+        builder->blockEnd(true);
+        if (stage + 1 < stageStarts.size()) {
+            builder->blockEnd(true);
+            continue;
+        }
+        msgStr = Util::printf_format("%s control: packet processing finished", sectionName);
+        builder->target->emitTraceMessage(builder, msgStr.c_str());
+
+        // DEPARSER
+        builder->emitIndent();
+        builder->blockStart();
+        msgStr = Util::printf_format("%s deparser: packet deparsing started", sectionName);
+        builder->target->emitTraceMessage(builder, msgStr.c_str());
+        deparser->emit(builder);
+        msgStr = Util::printf_format("%s deparser: packet deparsing finished", sectionName);
+        builder->target->emitTraceMessage(builder, msgStr.c_str());
+        builder->blockEnd(true);
+
+        // The Traffic Manager expects the output metadata in a structure.
+        auto ostd = control->outputStandardMetadata;
+        if (control->codeGen->isPointerVariable(ostd->name.name)) {
+            builder->emitIndent();
+            builder->blockStart();
+            auto type = EBPFTypeFactory::instance->create(typeMap->getType(ostd));
+            builder->emitIndent();
+            type->declare(builder, ostd->name.name, false);
+            builder->appendFormat(" = %s->%s", stageStateVar(), ostd->name.name);
+            builder->endOfStatement(true);
+            emitTrafficManager(builder);
+            builder->blockEnd(true);
+        } else {
+            emitTrafficManager(builder);
+        }
+        builder->blockEnd(true);
+    }
+}
+
 // =====================EBPFIngressPipeline===========================
 void EBPFIngressPipeline::emitSharedMetadataInitializer(CodeBuilder *builder) {
     auto type = EBPFTypeFactory::instance->create(this->deparser->resubmit_meta->type);
@@ -204,6 +459,24 @@ void EBPFIngressPipeline::emitPSAControlOutputMetadata(CodeBuilder *builder) {
     builder->newline();
 }
 
+void EBPFIngressPipeline::emitStageStateFields(CodeBuilder *builder) {
+    EBPFPipeline::emitStageStateFields(builder);
+    auto type = EBPFTypeFactory::instance->create(deparser->resubmit_meta->type);
+    builder->emitIndent();
+    type->declare(builder, deparser->resubmit_meta->name.name, false);
+    builder->endOfStatement(true);
+}
+
+void EBPFIngressPipeline::emitStageMetadataFromState(CodeBuilder *builder) {
+    EBPFPipeline::emitStageMetadataFromState(builder);
+    // only written by the deparser, which runs in the last stage
+    auto type = EBPFTypeFactory::instance->create(deparser->resubmit_meta->type);
+    builder->emitIndent();
+    type->declare(builder, deparser->resubmit_meta->name.name, true);
+    builder->appendFormat(" = &%s->%s", stageStateVar(), deparser->resubmit_meta->name.name);
+    builder->endOfStatement(true);
+}
+
 void EBPFIngressPipeline::emit(CodeBuilder *builder) {
     cstring msgStr, varStr;
 
@@ -261,20 +534,27 @@ void EBPFIngressPipeline::emit(CodeBuilder *builder) {
     emitPSAControlInputMetadata(builder);
     msgStr = Util::printf_format("%s control: packet processing started", sectionName);
     builder->target->emitTraceMessage(builder, msgStr.c_str());
-    control->emit(builder);
+    if (isSplit()) {
+        // the next stages end with the deparser
+        emitControlStage(builder, 0);
+    } else {
+        control->emit(builder);
+    }
     builder->blockEnd(true);
-    msgStr = Util::printf_format("%s control: packet processing finished", sectionName);
-    builder->target->emitTraceMessage(builder, msgStr.c_str());
+    if (!isSplit()) {
+        msgStr = Util::printf_format("%s control: packet processing finished", sectionName);
+        builder->target->emitTraceMessage(builder, msgStr.c_str());
 
-    // DEPARSER
-    builder->emitIndent();
-    builder->blockStart();
-    msgStr = Util::printf_format("%s deparser: packet deparsing started", sectionName);
-    builder->target->emitTraceMessage(builder, msgStr.c_str());
-    deparser->emit(builder);
-    msgStr = Util::printf_format("%s deparser: packet deparsing finished", sectionName);
-    builder->target->emitTraceMessage(builder, msgStr.c_str());
-    builder->blockEnd(true);
+        // DEPARSER
+        builder->emitIndent();
+        builder->blockStart();
+        msgStr = Util::printf_format("%s deparser: packet deparsing started", sectionName);
+        builder->target->emitTraceMessage(builder, msgStr.c_str());
+        deparser->emit(builder);
+        msgStr = Util::printf_format("%s deparser: packet deparsing finished", sectionName);
+        builder->target->emitTraceMessage(builder, msgStr.c_str());
+        builder->blockEnd(true);
+    }
 
     builder->emitIndent();
     builder->appendFormat("return %d;", actUnspecCode);
@@ -331,6 +611,16 @@ void EBPFIngressPipeline::emit(CodeBuilder *builder) {
                           control->outputStandardMetadata->name.name);
     builder->blockEnd(true);
 
+    if (isSplit()) {
+        // the Traffic Manager runs in the last stage
+        builder->emitIndent();
+        builder->append("return ret;");
+        builder->newline();
+        builder->blockEnd(true);
+        emitStageFunctions(builder);
+        return;
+    }
+
     builder->emitIndent();
     builder->appendFormat("if (ret != %d) {\n"
                         "        return ret;\n"
@@ -445,6 +735,14 @@ void EBPFEgressPipeline::emit(CodeBuilder *builder) {
     msgStr = Util::printf_format("%s control: packet processing started",
                                  sectionName);
     builder->target->emitTraceMessage(builder, msgStr.c_str());
+    if (isSplit()) {
+        // the next stages end with the deparser and the Traffic Manager
+        emitControlStage(builder, 0);
+        builder->blockEnd(true);
+        builder->blockEnd(true);
+        emitStageFunctions(builder);
+        return;
+    }
     control->emit(builder);
     builder->blockEnd(true);
     msgStr = Util::printf_format("%s control: packet processing finished",
@@ -640,4 +938,215 @@ void TCEgressPipeline::emitTrafficManager(CodeBuilder *builder) {
     builder->appendFormat("return %s", forwardReturnCode());
     builder->endOfStatement(true);
 }
+
+// =====================XDPIngressPipeline=============================
+void XDPIngressPipeline::emitGlobalMetadataInitializer(CodeBuilder *builder) {
+    // There is no skb->cb in XDP, global metadata only lives for a single run of the program.
+    builder->emitIndent();
+    builder->appendLine("struct psa_global_metadata global_metadata = {};");
+    builder->emitIndent();
+    builder->appendFormat("struct psa_global_metadata *%s = &global_metadata;",
+                          compilerGlobalMetadata);
+    builder->newline();
+}
+
+void XDPIngressPipeline::emitPacketLength(CodeBuilder *builder) {
+    builder->appendFormat("%s->data_end - %s->data",
+                          this->contextVar.c_str(), this->contextVar.c_str());
+}
+
+/*
+ * The Traffic Manager for XDP Ingress pipeline implements:
+ * - send to port, using the devmap
+ * - passing packets to clone or multicast up to TC
+ * The output metadata are stored in front of the packet (XDP metadata),
+ * where they are read by TCTrafficManagerForXDP and XDPEgressPipeline.
+ */
+void XDPIngressPipeline::emitTrafficManager(CodeBuilder *builder) {
+    cstring ostd = control->outputStandardMetadata->name.name;
+    cstring replicate = Util::printf_format("%s.clone || %s.multicast_group != 0",
+                                            ostd, ostd);
+
+    builder->emitIndent();
+    builder->appendFormat("int meta_ret = bpf_xdp_adjust_meta(%s, "
+                          "-(int)sizeof(struct xdp2tc_metadata))", contextVar.c_str());
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->appendFormat("struct xdp2tc_metadata *xdp_meta = "
+                          "(struct xdp2tc_metadata *)(long)%s->data_meta",
+                          contextVar.c_str());
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->appendFormat("if (meta_ret == 0 && "
+                          "(void *)(xdp_meta + 1) <= (void *)(long)%s->data) ",
+                          contextVar.c_str());
+    builder->blockStart();
+    builder->emitIndent();
+    builder->appendFormat("xdp_meta->ostd = %s", ostd);
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->appendFormat("xdp_meta->packet_path = %s->packet_path", compilerGlobalMetadata);
+    builder->endOfStatement(true);
+    builder->blockEnd(false);
+    builder->appendFormat(" else if (%s) ", replicate);
+    builder->blockStart();
+    builder->target->emitTraceMessage(builder,
+        "IngressTM: cannot pass metadata to TC, dropping packet");
+    builder->emitIndent();
+    builder->appendFormat("return %s", builder->target->abortReturnCode().c_str());
+    builder->endOfStatement(true);
+    builder->blockEnd(true);
+
+    builder->emitIndent();
+    builder->appendFormat("if (%s) ", replicate);
+    builder->blockStart();
+    builder->target->emitTraceMessage(builder,
+        "IngressTM: passing packet to TC for cloning/multicast");
+    builder->emitIndent();
+    builder->appendFormat("return %s", forwardReturnCode());
+    builder->endOfStatement(true);
+    builder->blockEnd(true);
+
+    cstring eg_port = Util::printf_format("%s.egress_port", ostd);
+    cstring cos = Util::printf_format("%s.class_of_service", ostd);
+    builder->target->emitTraceMessage(builder,
+            "IngressTM: Sending packet out of port %d with priority %d", 2, eg_port, cos);
+    builder->emitIndent();
+    builder->appendFormat("return bpf_redirect_map(&tx_port, %s, 0)", eg_port);
+    builder->endOfStatement(true);
+}
+
+// =====================XDPEgressPipeline=============================
+void XDPEgressPipeline::emitGlobalMetadataInitializer(CodeBuilder *builder) {
+    builder->emitIndent();
+    builder->appendLine("struct psa_global_metadata global_metadata = {};");
+    builder->emitIndent();
+    builder->appendFormat("struct psa_global_metadata *%s = &global_metadata;",
+                          compilerGlobalMetadata);
+    builder->newline();
+
+    // class_of_service is passed in the XDP metadata, if the driver preserves them
+    builder->emitIndent();
+    builder->appendFormat("ClassOfService_t %s = 0", priorityVar.c_str());
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->appendFormat("struct xdp2tc_metadata *xdp_meta = "
+                          "(struct xdp2tc_metadata *)(long)%s->data_meta",
+                          contextVar.c_str());
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->appendFormat("if ((void *)(xdp_meta + 1) <= (void *)(long)%s->data) ",
+                          contextVar.c_str());
+    builder->blockStart();
+    builder->emitIndent();
+    builder->appendFormat("%s = xdp_meta->ostd.class_of_service", priorityVar.c_str());
+    builder->endOfStatement(true);
+    builder->blockEnd(true);
+}
+
+void XDPEgressPipeline::emitPacketLength(CodeBuilder *builder) {
+    builder->appendFormat("%s->data_end - %s->data",
+                          this->contextVar.c_str(), this->contextVar.c_str());
+}
+
+/*
+ * The Traffic Manager for XDP Egress pipeline implements:
+ * - drop
+ * - send to port
+ * A devmap program can only drop or transmit a packet,
+ * so egress cloning and recirculation are not supported.
+ */
+void XDPEgressPipeline::emitTrafficManager(CodeBuilder *builder) {
+    cstring ostd = control->outputStandardMetadata->name.name;
+
+    builder->emitIndent();
+    builder->appendFormat("if (%s.clone) ", ostd);
+    builder->blockStart();
+    builder->target->emitTraceMessage(builder,
+        "EgressTM: egress cloning is not supported in XDP, ignoring");
+    builder->blockEnd(true);
+
+    builder->newline();
+
+    builder->emitIndent();
+    builder->appendFormat("if (%s.drop) ", ostd);
+    builder->blockStart();
+    builder->target->emitTraceMessage(builder, "EgressTM: Packet dropped due to metadata");
+    builder->emitIndent();
+    builder->appendFormat("return %s", dropReturnCode());
+    builder->endOfStatement(true);
+    builder->blockEnd(true);
+
+    builder->newline();
+
+    builder->emitIndent();
+    builder->appendFormat("if (%s.egress_port == P4C_PSA_PORT_RECIRCULATE) ",
+                          control->inputStandardMetadata->name.name);
+    builder->blockStart();
+    builder->target->emitTraceMessage(builder,
+        "EgressTM: recirculation is not supported in XDP, dropping packet");
+    builder->emitIndent();
+    builder->appendFormat("return %s", dropReturnCode());
+    builder->endOfStatement(true);
+    builder->blockEnd(true);
+
+    builder->newline();
+
+    builder->target->emitTraceMessage(builder, "EgressTM: output packet to port %d",
+                                      1, ifindexVar.c_str());
+    builder->emitIndent();
+    builder->appendFormat("return %s", forwardReturnCode());
+    builder->endOfStatement(true);
+}
+
+// =====================TCTrafficManagerForXDP=============================
+void TCTrafficManagerForXDP::emit(CodeBuilder *builder) {
+    cstring ostd = control->outputStandardMetadata->name.name;
+
+    builder->newline();
+    builder->target->emitCodeSection(builder, sectionName);
+    builder->emitIndent();
+    builder->target->emitMain(builder, functionName, model.CPacketName.str());
+    builder->spc();
+    builder->blockStart();
+
+    EBPFPipeline::emitGlobalMetadataInitializer(builder);
+
+    builder->emitIndent();
+    builder->appendFormat("struct xdp2tc_metadata *xdp_meta = "
+                          "(struct xdp2tc_metadata *)(long)%s->data_meta",
+                          contextVar.c_str());
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->appendFormat("if ((void *)(xdp_meta + 1) > (void *)(long)%s->data) ",
+                          contextVar.c_str());
+    builder->blockStart();
+    builder->target->emitTraceMessage(builder,
+        "IngressTM: no metadata from XDP, passing packet to the kernel");
+    builder->emitIndent();
+    builder->appendLine("return TC_ACT_UNSPEC;");
+    builder->blockEnd(true);
+
+    builder->emitIndent();
+    builder->appendFormat("struct psa_ingress_output_metadata_t %s = xdp_meta->ostd", ostd);
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->appendFormat("%s->packet_path = xdp_meta->packet_path", compilerGlobalMetadata);
+    builder->endOfStatement(true);
+    builder->newline();
+
+    // clones are created from the packet emitted by the XDP deparser
+    builder->emitIndent();
+    builder->appendFormat("if (%s.clone) ", ostd);
+    builder->blockStart();
+    builder->emitIndent();
+    builder->appendFormat("do_packet_clones(%s, &clone_session_tbl, %s.clone_session_id,"
+                          " CLONE_I2E, 1)", contextVar.c_str(), ostd);
+    builder->endOfStatement(true);
+    builder->blockEnd(true);
+
+    emitTrafficManager(builder);
+
+    builder->blockEnd(true);
+}
 }  // namespace EBPF
@@ -51,6 +51,10 @@ class EBPFPipeline : public EBPFProgram {
     EBPFControlPSA* control;
     EBPFDeparserPSA* deparser;
 
+    // Index in the control body of the first statement of each stage
+    // when the control is split into tail-called programs (--max-stage-insns).
+    std::vector<size_t> stageStarts;
+
     EBPFPipeline(cstring name, const EbpfOptions& options, P4::ReferenceMap* refMap,
                  P4::TypeMap* typeMap)
                  : EBPFProgram(options, nullptr, refMap, typeMap, nullptr),
@@ -75,6 +79,13 @@ class EBPFPipeline : public EBPFProgram {
      * Return false if not. */
     bool isEmpty() const;
 
+    void estimateComplexity() const override;
+
+    /* Splits the control into stages chained with tail calls,
+     * so that each one fits in the --max-stage-insns budget. */
+    void splitIntoStages();
+    bool isSplit() const { return stageStarts.size() > 1; }
+
     virtual cstring dropReturnCode() {
         if (sectionName.startsWith("xdp")) {
             return "XDP_DROP";
@@ -122,6 +133,16 @@ class EBPFPipeline : public EBPFProgram {
     void emitHeadersFromCPUMAP(CodeBuilder* builder);
     void emitMetadataFromCPUMAP(CodeBuilder *builder);
 
+    /* Generates the structure passing the state of the control between stages. */
+    void emitStageTypes(CodeBuilder *builder);
+    /* Generates the per-CPU map storing that state and the program array of the stages. */
+    void emitStageInstances(CodeBuilder *builder);
+    /* Generates the statements of the control that belong to 'stage'
+     * followed by the tail call to the next one, if any. */
+    void emitControlStage(CodeBuilder *builder, size_t stage);
+    /* Generates a program for each stage of the control but the first one. */
+    void emitStageFunctions(CodeBuilder *builder);
+
     bool hasAnyMeter() const {
         auto directMeter = std::find_if(control->tables.begin(),
                                         control->tables.end(),
@@ -131,6 +152,12 @@ class EBPFPipeline : public EBPFProgram {
         bool anyDirectMeter = directMeter != control->tables.end();
         return anyDirectMeter || (!control->meters.empty());
     }
+    bool hasAnyPerCpuMeter() const {
+        return std::any_of(control->meters.begin(), control->meters.end(),
+                           [](std::pair<const cstring, EBPFMeterPSA*> elem) {
+                               return elem.second->isPerCpu;
+                           });
+    }
     /*
      * Returns whether the compiler should generate
      * timestamp retrieved by bpf_ktime_get_ns().
@@ -141,6 +168,15 @@ class EBPFPipeline : public EBPFProgram {
     bool shouldEmitTimestamp() const {
         return hasAnyMeter() || control->timestampIsUsed;
     }
+
+ protected:
+    cstring stagePrefix() const { return name.replace("-", "_"); }
+    cstring stageStateVar() const { return EBPFModel::reserved("stage"); }
+    cstring stageFunctionName(size_t stage) const;
+    void emitStageStateLookup(CodeBuilder *builder);
+    void emitStageLocals(CodeBuilder *builder, bool save);
+    virtual void emitStageStateFields(CodeBuilder *builder);
+    virtual void emitStageMetadataFromState(CodeBuilder *builder);
 };
 
 /*
@@ -168,6 +204,10 @@ class EBPFIngressPipeline : public EBPFPipeline {
     void emit(CodeBuilder *builder) override;
     void emitPSAControlInputMetadata(CodeBuilder* builder) override;
     void emitPSAControlOutputMetadata(CodeBuilder* builder) override;
+
+ protected:
+    void emitStageStateFields(CodeBuilder *builder) override;
+    void emitStageMetadataFromState(CodeBuilder *builder) override;
 };
 
 /*
@@ -207,6 +247,58 @@ class TCEgressPipeline : public EBPFEgressPipeline {
 
     void emitTrafficManager(CodeBuilder *builder) override;
 };
+
+/*
+ * XDPIngressPipeline runs the PSA Ingress pipeline in the XDP hook.
+ * Unicast packets are redirected to the egress port through the devmap,
+ * packets to clone or multicast are passed to TCTrafficManagerForXDP.
+ */
+class XDPIngressPipeline : public EBPFIngressPipeline {
+ public:
+    XDPIngressPipeline(cstring name, const EbpfOptions& options, P4::ReferenceMap* refMap,
+                       P4::TypeMap* typeMap) :
+            EBPFIngressPipeline(name, options, refMap, typeMap) {
+        sectionName = "xdp_ingress/" + name;
+        ifindexVar = cstring("skb->ingress_ifindex");
+    }
+
+    void emitGlobalMetadataInitializer(CodeBuilder *builder) override;
+    void emitPacketLength(CodeBuilder *builder) override;
+    void emitTrafficManager(CodeBuilder *builder) override;
+};
+
+/*
+ * XDPEgressPipeline runs the PSA Egress pipeline as a devmap program,
+ * for packets redirected by XDPIngressPipeline.
+ */
+class XDPEgressPipeline : public EBPFEgressPipeline {
+ public:
+    XDPEgressPipeline(cstring name, const EbpfOptions& options, P4::ReferenceMap* refMap,
+                      P4::TypeMap* typeMap) :
+            EBPFEgressPipeline(name, options, refMap, typeMap) {
+        sectionName = "xdp_devmap/" + name;
+        ifindexVar = cstring("skb->egress_ifindex");
+        priorityVar = cstring("class_of_service");
+    }
+
+    void emitGlobalMetadataInitializer(CodeBuilder *builder) override;
+    void emitPacketLength(CodeBuilder *builder) override;
+    void emitTrafficManager(CodeBuilder *builder) override;
+};
+
+/*
+ * TCTrafficManagerForXDP is attached to TC Ingress if the PSA pipelines run in XDP.
+ * It does not run any P4 code, but completes the Traffic Manager work that cannot be
+ * done in XDP (packet cloning and multicast) for packets passed by XDPIngressPipeline.
+ */
+class TCTrafficManagerForXDP : public TCIngressPipeline {
+ public:
+    TCTrafficManagerForXDP(cstring name, const EbpfOptions& options, P4::ReferenceMap* refMap,
+                           P4::TypeMap* typeMap) :
+            TCIngressPipeline(name, options, refMap, typeMap) {}
+
+    void emit(CodeBuilder* builder) override;
+};
 }  // namespace EBPF
 
 #endif /* BACKENDS_EBPF_PSA_EBPFPIPELINE_H_ */
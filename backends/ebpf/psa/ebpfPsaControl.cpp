@@ -98,10 +98,10 @@ cstring ControlBodyTranslatorPSA::getParamName(const IR::PathExpression *expr) {
     return expr->path->name.name;
 }
 
-void EBPFControlPSA::emit(CodeBuilder *builder) {
+void EBPFControlPSA::emitDeclarations(CodeBuilder *builder) {
     for (auto h : hashes)
         h.second->emitVariables(builder);
-    EBPFControl::emit(builder);
+    EBPFControl::emitDeclarations(builder);
 }
 
 void EBPFControlPSA::emitTableTypes(CodeBuilder *builder) {
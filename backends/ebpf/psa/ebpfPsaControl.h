@@ -73,7 +73,7 @@ class EBPFControlPSA : public EBPFControl {
                    const IR::Parameter* parserHeaders) :
         EBPFControl(program, control, parserHeaders) {}
 
-    void emit(CodeBuilder* builder) override;
+    void emitDeclarations(CodeBuilder* builder) override;
     void emitTableTypes(CodeBuilder* builder) override;
     void emitTableInstances(CodeBuilder* builder) override;
     void emitTableInitializers(CodeBuilder* builder) override;
@@ -114,6 +114,39 @@ bool IngressDeparserPSA::build() {
     return true;
 }
 
+/*
+ * PreDeparser for Ingress pipeline implements:
+ * - early packet drop
+ * - resubmission
+ */
+void IngressDeparserPSA::emitPreDeparser(CodeBuilder *builder) {
+    CHECK_NULL(program);
+    auto pipeline = dynamic_cast<const EBPFPipeline*>(program);
+
+    // early drop
+    builder->emitIndent();
+    builder->appendFormat("if (%s->drop) ", istd->name.name);
+    builder->blockStart();
+    builder->target->emitTraceMessage(builder, "PreDeparser: dropping packet..");
+    builder->emitIndent();
+    builder->appendFormat("return %s;\n", builder->target->dropReturnCode().c_str());
+    builder->blockEnd(true);
+
+    // if packet should be resubmitted, we skip deparser
+    builder->emitIndent();
+    builder->appendFormat("if (%s->resubmit) ", istd->name.name);
+    builder->blockStart();
+    builder->target->emitTraceMessage(builder, "PreDeparser: resubmitting packet, "
+                                               "skipping deparser..");
+    builder->emitIndent();
+    builder->appendFormat("%s->packet_path = RESUBMIT;",
+                          pipeline->compilerGlobalMetadata);
+    builder->newline();
+    builder->emitIndent();
+    builder->appendLine("return TC_ACT_UNSPEC;");
+    builder->blockEnd(true);
+}
+
 // =====================EgressDeparserPSA=============================
 bool EgressDeparserPSA::build() {
     auto pl = controlBlock->container->type->applyParams;
@@ -132,10 +165,8 @@ bool EgressDeparserPSA::build() {
 
 // =====================TCIngressDeparserPSA=============================
 /*
- * PreDeparser for Ingress pipeline implements:
- * - packet cloning (using clone sessions)
- * - early packet drop
- * - resubmission
+ * PreDeparser for TC Ingress pipeline implements packet cloning
+ * (using clone sessions) on top of the common PreDeparser.
  */
 void TCIngressDeparserPSA::emitPreDeparser(CodeBuilder *builder) {
     builder->emitIndent();
@@ -152,29 +183,6 @@ void TCIngressDeparserPSA::emitPreDeparser(CodeBuilder *builder) {
     builder->newline();
     builder->blockEnd(true);
 
-    // early drop
-    builder->emitIndent();
-    builder->appendFormat("if (%s->drop) ", istd->name.name);
-    builder->blockStart();
-    builder->target->emitTraceMessage(builder, "PreDeparser: dropping packet..");
-    builder->emitIndent();
-    builder->appendFormat("return %s;\n", builder->target->abortReturnCode().c_str());
-    builder->blockEnd(true);
-
-    // if packet should be resubmitted, we skip deparser
-    builder->emitIndent();
-    builder->appendFormat("if (%s->resubmit) ", istd->name.name);
-    builder->blockStart();
-    builder->target->emitTraceMessage(builder, "PreDeparser: resubmitting packet, "
-                                               "skipping deparser..");
-    builder->emitIndent();
-    CHECK_NULL(program);
-    auto pipeline = dynamic_cast<const EBPFPipeline*>(program);
-    builder->appendFormat("%s->packet_path = RESUBMIT;",
-                          pipeline->compilerGlobalMetadata);
-    builder->newline();
-    builder->emitIndent();
-    builder->appendLine("return TC_ACT_UNSPEC;");
-    builder->blockEnd(true);
+    IngressDeparserPSA::emitPreDeparser(builder);
 }
 }  // namespace EBPF
@@ -70,6 +70,7 @@ class IngressDeparserPSA : public EBPFDeparserPSA {
             EBPFDeparserPSA(program, control, parserHeaders, istd) {}
 
     bool build() override;
+    void emitPreDeparser(CodeBuilder *builder) override;
 };
 
 class EgressDeparserPSA : public EBPFDeparserPSA {
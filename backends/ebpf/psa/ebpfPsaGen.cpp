@@ -129,12 +129,17 @@ void PSAEbpfGenerator::emitTypes(CodeBuilder *builder) const {
 
     if (ingress->hasAnyMeter() || egress->hasAnyMeter())
         EBPFMeterPSA::emitValueStruct(builder, ingress->refMap);
+    if (ingress->hasAnyPerCpuMeter() || egress->hasAnyPerCpuMeter())
+        EBPFMeterPSA::emitLocalValueStruct(builder, ingress->refMap);
 
     ingress->parser->emitTypes(builder);
     ingress->control->emitTableTypes(builder);
     egress->parser->emitTypes(builder);
     egress->control->emitTableTypes(builder);
     builder->newline();
+
+    ingress->emitStageTypes(builder);
+    egress->emitStageTypes(builder);
 }
 
 void PSAEbpfGenerator::emitGlobalHeadersMetadata(CodeBuilder *builder) const {
@@ -183,6 +188,9 @@ void PSAEbpfGenerator::emitPipelineInstances(CodeBuilder *builder) const {
     builder->target->emitTableDecl(builder, "hdr_md_cpumap",
                                    TablePerCPUArray, "u32",
                                    "struct hdr_md", 2);
+
+    ingress->emitStageInstances(builder);
+    egress->emitStageInstances(builder);
 }
 
 void PSAEbpfGenerator::emitInitializer(CodeBuilder *builder) const {
@@ -312,12 +320,23 @@ void PSAEbpfGenerator::emitHelperFunctions(CodeBuilder *builder) const {
         builder->appendLine(meterExecuteFunc);
         builder->newline();
     }
+    if (ingress->hasAnyPerCpuMeter() || egress->hasAnyPerCpuMeter()) {
+        cstring meterExecuteFunc =
+                EBPFMeterPSA::meterExecutePerCpuFunc(options.emitTraceMessages, ingress->refMap);
+        builder->appendLine(meterExecuteFunc);
+        builder->newline();
+    }
 
     cstring addPrefixFunc = EBPFTablePSA::addPrefixFunc(options.emitTraceMessages);
     builder->appendLine(addPrefixFunc);
     builder->newline();
 }
 
+void PSAEbpfGenerator::estimateComplexity() const {
+    ingress->estimateComplexity();
+    egress->estimateComplexity();
+}
+
 // =====================PSAArchTC=============================
 void PSAArchTC::emit(CodeBuilder *builder) const {
     /**
@@ -413,6 +432,116 @@ void PSAArchTC::emitInitializerSection(CodeBuilder *builder) const {
     builder->appendLine("SEC(\"classifier/map-initializer\")");
 }
 
+// =====================PSAArchXDP=============================
+void PSAArchXDP::emit(CodeBuilder *builder) const {
+    /**
+     * The structure of a single C program for PSA in the XDP mode:
+     * 1. Automatically generated comment
+     * 2. Includes
+     * 3. Macro definitions (it's called "preamble")
+     * 4. Headers, structs, types, PSA-specific data types.
+     * 5. BPF map definitions.
+     * 6. Helper functions
+     * 7. BPF map initialization
+     * 8. XDP Ingress and Egress programs.
+     * 9. TC programs for packet replication.
+     */
+
+    // 1. Automatically generated comment.
+    ingress->emitGeneratedComment(builder);
+
+    /*
+     * 2. Includes.
+     */
+    builder->target->emitIncludes(builder);
+    emitPSAIncludes(builder);
+
+    /*
+     * 3. Macro definitions (it's called "preamble")
+     */
+    emitPreamble(builder);
+
+    /*
+     * 4. Headers, structs, types, PSA-specific data types.
+     */
+    emitInternalStructures(builder);
+    // output metadata passed from the XDP Ingress program, in front of the packet
+    builder->appendLine("struct xdp2tc_metadata {\n"
+                        "    struct psa_ingress_output_metadata_t ostd;\n"
+                        "    PSA_PacketPath_t packet_path;\n"
+                        "} __attribute__((aligned(4)));");
+    builder->newline();
+    emitTypes(builder);
+    emitGlobalHeadersMetadata(builder);
+
+    /*
+     * 5. BPF map definitions.
+     */
+    emitInstances(builder);
+
+    /*
+     * 6. Helper functions for ingress and egress program.
+     */
+    emitHelperFunctions(builder);
+
+    /*
+     * 7. BPF map initialization.
+     */
+    emitInitializer(builder);
+    builder->newline();
+
+    /*
+     * 8. XDP Ingress and Egress programs, generated with XDP return codes and helpers.
+     */
+    auto tcTarget = builder->target;
+    builder->target = xdpTarget;
+    ingress->emit(builder);
+    if (!egress->isEmpty()) {
+        egress->emit(builder);
+    }
+    builder->target = tcTarget;
+
+    /*
+     * 9. TC programs for packets that are cloned or multicast.
+     */
+    tcTrafficManager->emit(builder);
+    if (!tcEgress->isEmpty()) {
+        tcEgress->emit(builder);
+    }
+
+    builder->target->emitLicense(builder, ingress->license);
+}
+
+void PSAArchXDP::emitPreamble(CodeBuilder *builder) const {
+    PSAEbpfGenerator::emitPreamble(builder);
+    builder->appendFormat("#define DEVMAP_SIZE %u", DevmapSize);
+    builder->newline();
+    builder->newline();
+}
+
+void PSAArchXDP::emitInstances(CodeBuilder *builder) const {
+    builder->appendLine("REGISTER_START()");
+
+    builder->target->emitTableDecl(builder, "tx_port", TableDevmapHash, "u32",
+                                   "struct bpf_devmap_val", DevmapSize);
+
+    emitPacketReplicationTables(builder);
+    emitPipelineInstances(builder);
+
+    builder->appendLine("REGISTER_END()");
+    builder->newline();
+}
+
+void PSAArchXDP::emitInitializerSection(CodeBuilder *builder) const {
+    builder->appendLine("SEC(\"xdp/map-initializer\")");
+}
+
+void PSAArchXDP::estimateComplexity() const {
+    PSAEbpfGenerator::estimateComplexity();
+    // the traffic manager only replicates packets processed by the XDP ingress
+    tcEgress->estimateComplexity();
+}
+
 // =====================ConvertToEbpfPSA=============================
 const PSAEbpfGenerator * ConvertToEbpfPSA::build(const IR::ToplevelBlock *tlb) {
     /*
@@ -461,31 +590,58 @@ const PSAEbpfGenerator * ConvertToEbpfPSA::build(const IR::ToplevelBlock *tlb) {
     auto egressDeparser = egress->getParameterValue("ed");
     BUG_CHECK(egressDeparser != nullptr, "No egress deparser block found");
 
+    if (options.generateToXDP) {
+        if (options.maxStageInsns != 0) {
+            ::warning(ErrorType::WARN_UNSUPPORTED,
+                      "--max-stage-insns is not supported with --xdp, "
+                      "the pipelines will not be split");
+        }
+        auto xdpIngress = convertPipeline("xdp-ingress", XDP_INGRESS, tlb, ingress,
+                                          ingressParser, ingressControl, ingressDeparser);
+        auto xdpEgress = convertPipeline("xdp-egress", XDP_EGRESS, tlb, egress,
+                                         egressParser, egressControl, egressDeparser);
+        auto tcTrafficManager = convertPipeline("tc-ingress", TC_TRAFFIC_MANAGER, tlb, ingress,
+                                                ingressParser, ingressControl, ingressDeparser);
+        auto tcEgress = convertPipeline("tc-egress", TC_EGRESS, tlb, egress,
+                                        egressParser, egressControl, egressDeparser);
+        tcTrafficManager->program = tlb->getProgram();
+        tcEgress->program = tlb->getProgram();
+
+        return new PSAArchXDP(options, ebpfTypes, xdpIngress, xdpEgress,
+                              tcTrafficManager, tcEgress);
+    }
+
     auto xdp = new XDPHelpProgram(options);
 
-    auto ingress_pipeline_converter =
-        new ConvertToEbpfPipeline("tc-ingress", TC_INGRESS, options,
-            ingressParser->to<IR::ParserBlock>(),
-            ingressControl->to<IR::ControlBlock>(),
-            ingressDeparser->to<IR::ControlBlock>(),
-            refmap, typemap);
-    ingress->apply(*ingress_pipeline_converter);
-    tlb->getProgram()->apply(*ingress_pipeline_converter);
-    auto tcIngress = ingress_pipeline_converter->getEbpfPipeline();
-
-    auto egress_pipeline_converter =
-        new ConvertToEbpfPipeline("tc-egress", TC_EGRESS, options,
-            egressParser->to<IR::ParserBlock>(),
-            egressControl->to<IR::ControlBlock>(),
-            egressDeparser->to<IR::ControlBlock>(),
-            refmap, typemap);
-    egress->apply(*egress_pipeline_converter);
-    tlb->getProgram()->apply(*egress_pipeline_converter);
-    auto tcEgress = egress_pipeline_converter->getEbpfPipeline();
+    auto tcIngress = convertPipeline("tc-ingress", TC_INGRESS, tlb, ingress,
+                                     ingressParser, ingressControl, ingressDeparser);
+    auto tcEgress = convertPipeline("tc-egress", TC_EGRESS, tlb, egress,
+                                    egressParser, egressControl, egressDeparser);
+    if (options.maxStageInsns != 0) {
+        tcIngress->splitIntoStages();
+        tcEgress->splitIntoStages();
+    }
 
     return new PSAArchTC(options, ebpfTypes, xdp, tcIngress, tcEgress);
 }
 
+EBPFPipeline *ConvertToEbpfPSA::convertPipeline(cstring name, pipeline_type type,
+                                                const IR::ToplevelBlock *tlb,
+                                                const IR::PackageBlock *package,
+                                                const IR::CompileTimeValue *parser,
+                                                const IR::CompileTimeValue *control,
+                                                const IR::CompileTimeValue *deparser) {
+    auto pipeline_converter =
+        new ConvertToEbpfPipeline(name, type, options,
+            parser->to<IR::ParserBlock>(),
+            control->to<IR::ControlBlock>(),
+            deparser->to<IR::ControlBlock>(),
+            refmap, typemap);
+    package->apply(*pipeline_converter);
+    tlb->getProgram()->apply(*pipeline_converter);
+    return pipeline_converter->getEbpfPipeline();
+}
+
 const IR::Node *ConvertToEbpfPSA::preorder(IR::ToplevelBlock *tlb) {
     ebpf_psa_arch = build(tlb);
     ebpf_psa_arch->ingress->program = tlb->getProgram();
@@ -500,6 +656,12 @@ bool ConvertToEbpfPipeline::preorder(const IR::PackageBlock *block) {
         pipeline = new TCIngressPipeline(name, options, refmap, typemap);
     } else if (type == TC_EGRESS) {
         pipeline = new TCEgressPipeline(name, options, refmap, typemap);
+    } else if (type == XDP_INGRESS) {
+        pipeline = new XDPIngressPipeline(name, options, refmap, typemap);
+    } else if (type == XDP_EGRESS) {
+        pipeline = new XDPEgressPipeline(name, options, refmap, typemap);
+    } else if (type == TC_TRAFFIC_MANAGER) {
+        pipeline = new TCTrafficManagerForXDP(name, options, refmap, typemap);
     } else {
         ::error(ErrorType::ERR_INVALID, "unknown type of pipeline");
         return false;
@@ -536,7 +698,7 @@ bool ConvertToEBPFParserPSA::preorder(const IR::ParserBlock *prsr) {
 
     // ingress parser
     unsigned numOfParams = 6;
-    if (type == TC_EGRESS) {
+    if (type == TC_EGRESS || type == XDP_EGRESS) {
         // egress parser
         numOfParams = 7;
     }
@@ -597,7 +759,7 @@ bool ConvertToEBPFControlPSA::preorder(const IR::ControlBlock *ctrl) {
     auto codegen = new ControlBodyTranslatorPSA(control);
     codegen->substitute(control->headers, parserHeaders);
 
-    if (type != TC_EGRESS) {
+    if (type != TC_EGRESS && type != XDP_EGRESS) {
         codegen->useAsPointerVariable(control->outputStandardMetadata->name.name);
     }
 
@@ -642,7 +804,7 @@ bool ConvertToEBPFControlPSA::preorder(const IR::IfStatement *ifState) {
 }
 
 bool ConvertToEBPFControlPSA::preorder(const IR::Declaration_Variable* decl) {
-    if (type == TC_INGRESS) {
+    if (type == TC_INGRESS || type == XDP_INGRESS || type == TC_TRAFFIC_MANAGER) {
         if (decl->type->is<IR::Type_Name>() &&
             decl->type->to<IR::Type_Name>()->path->name.name == "psa_ingress_output_metadata_t") {
                 control->codeGen->useAsPointerVariable(decl->name.name);
@@ -692,10 +854,14 @@ bool ConvertToEBPFControlPSA::preorder(const IR::ExternBlock* instance) {
 
 // =====================EBPFDeparser=============================
 bool ConvertToEBPFDeparserPSA::preorder(const IR::ControlBlock *ctrl) {
-    if (pipelineType == TC_INGRESS) {
+    if (pipelineType == TC_INGRESS || pipelineType == TC_TRAFFIC_MANAGER) {
         deparser = new TCIngressDeparserPSA(program, ctrl, parserHeaders, istd);
     } else if (pipelineType == TC_EGRESS) {
         deparser = new TCEgressDeparserPSA(program, ctrl, parserHeaders, istd);
+    } else if (pipelineType == XDP_INGRESS) {
+        deparser = new IngressDeparserPSA(program, ctrl, parserHeaders, istd);
+    } else if (pipelineType == XDP_EGRESS) {
+        deparser = new EgressDeparserPSA(program, ctrl, parserHeaders, istd);
     } else {
         BUG("undefined pipeline type, cannot build deparser");
     }
@@ -707,7 +873,7 @@ bool ConvertToEBPFDeparserPSA::preorder(const IR::ControlBlock *ctrl) {
     deparser->codeGen->substitute(deparser->headers, parserHeaders);
     deparser->codeGen->useAsPointerVariable(deparser->headers->name.name);
 
-    if (pipelineType == TC_INGRESS) {
+    if (pipelineType != TC_EGRESS && pipelineType != XDP_EGRESS) {
         deparser->codeGen->useAsPointerVariable(deparser->resubmit_meta->name.name);
         deparser->codeGen->useAsPointerVariable(deparser->user_metadata->name.name);
     }
@@ -723,7 +889,7 @@ bool ConvertToEBPFDeparserPSA::preorder(const IR::Declaration_Instance *di) {
         auto typeName = baseType->to<IR::Type_Name>();
         auto digest = typeName->path->name.name;
         if (digest == "Digest") {
-            if (pipelineType == TC_EGRESS) {
+            if (pipelineType == TC_EGRESS || pipelineType == XDP_EGRESS) {
                 ::error(ErrorType::ERR_UNEXPECTED,
                         "Digests are only supported at ingress, got an instance at egress");
             }
@@ -30,7 +30,10 @@ namespace EBPF {
 
 enum pipeline_type {
     TC_INGRESS,
-    TC_EGRESS
+    TC_EGRESS,
+    XDP_INGRESS,
+    XDP_EGRESS,
+    TC_TRAFFIC_MANAGER
 };
 
 class PSAEbpfGenerator {
@@ -62,6 +65,8 @@ class PSAEbpfGenerator {
     void emitInitializer(CodeBuilder *builder) const;
     virtual void emitInitializerSection(CodeBuilder *builder) const = 0;
     void emitHelperFunctions(CodeBuilder *builder) const;
+    // Reports the estimated size of each pipeline (--insn-budget).
+    virtual void estimateComplexity() const;
 };
 
 class PSAArchTC : public PSAEbpfGenerator {
@@ -78,6 +83,35 @@ class PSAArchTC : public PSAEbpfGenerator {
     void emitInitializerSection(CodeBuilder *builder) const override;
 };
 
+/*
+ * PSAArchXDP runs the PSA pipelines in XDP. The Ingress pipeline is attached to XDP
+ * and the Egress pipeline is attached to the devmap used to redirect packets.
+ * Packet replication cannot be done in XDP, so it is delegated to a TC program
+ * (the traffic manager); replicated packets are processed by the TC Egress program.
+ */
+class PSAArchXDP : public PSAEbpfGenerator {
+ public:
+    static const unsigned DevmapSize = 256;
+
+    const Target* xdpTarget;
+    EBPFPipeline* tcTrafficManager;
+    EBPFPipeline* tcEgress;
+
+    PSAArchXDP(const EbpfOptions &options, std::vector<EBPFType*> &ebpfTypes,
+               EBPFPipeline* xdpIngress, EBPFPipeline* xdpEgress,
+               EBPFPipeline* tcTrafficManager, EBPFPipeline* tcEgress) :
+            PSAEbpfGenerator(options, ebpfTypes, xdpIngress, xdpEgress),
+            xdpTarget(new XdpTarget(options.emitTraceMessages)),
+            tcTrafficManager(tcTrafficManager), tcEgress(tcEgress) { }
+
+    void emit(CodeBuilder* builder) const override;
+
+    void emitPreamble(CodeBuilder* builder) const override;
+    void emitInstances(CodeBuilder *builder) const override;
+    void emitInitializerSection(CodeBuilder *builder) const override;
+    void estimateComplexity() const override;
+};
+
 class ConvertToEbpfPSA : public Transform {
     const EbpfOptions& options;
     BMV2::PsaProgramStructure& structure;
@@ -85,6 +119,13 @@ class ConvertToEbpfPSA : public Transform {
     P4::ReferenceMap* refmap;
     const PSAEbpfGenerator* ebpf_psa_arch;
 
+    EBPFPipeline *convertPipeline(cstring name, pipeline_type type,
+                                  const IR::ToplevelBlock *tlb,
+                                  const IR::PackageBlock *package,
+                                  const IR::CompileTimeValue *parser,
+                                  const IR::CompileTimeValue *control,
+                                  const IR::CompileTimeValue *deparser);
+
  public:
     ConvertToEbpfPSA(const EbpfOptions &options,
                      BMV2::PsaProgramStructure &structure,
@@ -233,6 +233,85 @@ EBPFTablePSA::EBPFTablePSA(const EBPFProgram* program, const IR::TableBlock* tab
     initDirectCounters();
     initDirectMeters();
     initImplementation();
+
+    constEntriesInlined = shouldInlineConstEntries();
+    tableCacheEnabled = program->options.enableTableCache && isTernaryTable() &&
+                        counters.empty() && meters.empty() && !constEntriesInlined;
+    arrayMapEnabled = !constEntriesInlined && shouldUseArrayMap();
+}
+
+bool EBPFTablePSA::shouldInlineConstEntries() {
+    unsigned int maxEntries = program->options.inlineConstEntriesMax;
+    if (maxEntries == 0 || implementation != nullptr || keyGenerator == nullptr ||
+        !counters.empty() || !meters.empty())
+        return false;
+
+    auto entriesProperty = table->container->properties->getProperty(
+        IR::TableProperties::entriesPropertyName);
+    if (entriesProperty == nullptr || !entriesProperty->isConstant)
+        return false;
+    auto entries = table->container->getEntries();
+    if (entries == nullptr || entries->size() > maxEntries)
+        return false;
+
+    for (auto keyElement : keyGenerator->keyElements) {
+        auto ebpfType = ::get(keyTypes, keyElement);
+        if (ebpfType == nullptr)
+            return false;
+        if (auto scalar = ebpfType->to<EBPFScalarType>()) {
+            if (!EBPFScalarType::generatesScalar(scalar->widthInBits()))
+                return false;
+        } else if (!ebpfType->is<EBPFBoolType>()) {
+            return false;
+        }
+    }
+
+    for (auto entry : entries->entries) {
+        // entries with an explicit priority would have to be sorted, use the map instead
+        if (entry->getAnnotation("priority") != nullptr)
+            return false;
+        for (auto k : entry->keys->components) {
+            if (k->is<IR::Range>())
+                return false;
+            if (auto km = k->to<IR::Mask>()) {
+                if (!km->left->is<IR::Constant>() || !km->right->is<IR::Constant>())
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool EBPFTablePSA::shouldUseArrayMap() {
+    unsigned int maxWidth = program->options.arrayTableMaxKeyWidth;
+    if (maxWidth == 0 || implementation != nullptr || keyGenerator == nullptr ||
+        keyGenerator->keyElements.size() != 1 || isTernaryTable() || isLPMTable())
+        return false;
+
+    auto keyElement = keyGenerator->keyElements.at(0);
+    if (keyElement->matchType->path->name.name != P4::P4CoreLibrary::instance.exactMatch.name)
+        return false;
+    auto ebpfType = ::get(keyTypes, keyElement);
+    if (ebpfType == nullptr || !ebpfType->is<EBPFScalarType>())
+        return false;
+    unsigned int width = ebpfType->to<EBPFScalarType>()->widthInBits();
+    if (width > maxWidth)
+        return false;
+
+    // Every possible key has its slot in the array map, the size property does not apply.
+    arrayMapKeyWidth = width;
+    return true;
+}
+
+void EBPFTablePSA::emitArrayMapIndex(CodeBuilder *builder, cstring keyName,
+                                     cstring indexName) const {
+    auto keyElement = keyGenerator->keyElements.at(0);
+    cstring fieldName = ::get(keyFieldNames, keyElement);
+    builder->emitIndent();
+    builder->appendFormat("%s %s = %s.%s", program->arrayIndexType.c_str(), indexName.c_str(),
+                          keyName.c_str(), fieldName.c_str());
+    builder->endOfStatement(true);
 }
 
 EBPFTablePSA::EBPFTablePSA(const EBPFProgram* program, CodeGenInspector* codeGen, cstring name) :
@@ -302,11 +381,26 @@ void EBPFTablePSA::emitValueStructStructure(CodeBuilder* builder) {
     } else {
         EBPFTable::emitValueStructStructure(builder);
     }
+
+    if (arrayMapEnabled) {
+        // array map slots always exist, an entry is present only if it is marked as valid
+        builder->emitIndent();
+        builder->appendLine("__u8 valid;");
+    }
 }
 
 void EBPFTablePSA::emitInstance(CodeBuilder *builder) {
-    if (isTernaryTable()) {
+    if (constEntriesInlined) {
+        // only the default action can be changed by the control plane
+    } else if (isTernaryTable()) {
         emitTernaryInstance(builder);
+        if (tableCacheEnabled) {
+            builder->target->emitTableDecl(builder, cacheMapName, TableHashLRU,
+                                           "struct " + keyTypeName,
+                                           "struct " + cacheValueTypeName, size);
+            builder->target->emitTableDecl(builder, cacheGenerationMapName, TableArray,
+                                           program->arrayIndexType, "__u32", 1);
+        }
         if (hasConstEntries()) {
             auto entries = getConstEntriesGroupedByPrefix();
             // A number of tuples is equal to number of unique prefixes
@@ -318,6 +412,11 @@ void EBPFTablePSA::emitInstance(CodeBuilder *builder) {
                                                "struct " + valueTypeName, size);
             }
         }
+    } else if (arrayMapEnabled) {
+        builder->target->emitTableDecl(builder, instanceName, TableArray,
+                                       program->arrayIndexType,
+                                       cstring("struct ") + valueTypeName,
+                                       1U << arrayMapKeyWidth);
     } else {
         TableKind kind = isLPMTable() ? TableLPMTrie : TableHash;
         builder->target->emitTableDecl(builder, instanceName, kind,
@@ -335,7 +434,22 @@ void EBPFTablePSA::emitInstance(CodeBuilder *builder) {
 
 void EBPFTablePSA::emitTypes(CodeBuilder* builder) {
     EBPFTable::emitTypes(builder);
-    // TODO: placeholder for handling PSA-specific types
+    if (tableCacheEnabled) {
+        // Result of a lookup tagged with the generation of the table content it was
+        // computed from; misses are cached too.
+        builder->emitIndent();
+        builder->appendFormat("struct %s ", cacheValueTypeName.c_str());
+        builder->blockStart();
+        builder->emitIndent();
+        builder->appendLine("__u32 generation;");
+        builder->emitIndent();
+        builder->appendLine("__u8 hit;");
+        builder->emitIndent();
+        builder->appendFormat("struct %s value;", valueTypeName.c_str());
+        builder->newline();
+        builder->blockEnd(false);
+        builder->endOfStatement(true);
+    }
 }
 
 /**
@@ -366,7 +480,8 @@ void EBPFTablePSA::emitInitializer(CodeBuilder *builder) {
     // Error for such case is printed when adding implementation to a table.
     if (implementation == nullptr) {
         this->emitDefaultActionInitializer(builder);
-        this->emitConstEntriesInitializer(builder);
+        if (!constEntriesInlined)
+            this->emitConstEntriesInitializer(builder);
     }
 }
 
@@ -457,6 +572,12 @@ void EBPFTablePSA::emitConstEntriesInitializer(CodeBuilder *builder) {
             auto *mce = entry->action->to<IR::MethodCallExpression>();
             emitTableValue(builder, mce, valueName.c_str());
 
+            if (arrayMapEnabled) {
+                auto indexName = program->refMap->newName("index");
+                emitArrayMapIndex(builder, keyName, indexName);
+                keyName = indexName;
+            }
+
             // emit update
             auto ret = program->refMap->newName("ret");
             builder->emitIndent();
@@ -552,10 +673,211 @@ void EBPFTablePSA::emitTableValue(CodeBuilder* builder, const IR::MethodCallExpr
         builder->append(",");
     }
     builder->append("}},\n");
+    if (arrayMapEnabled) {
+        builder->emitIndent();
+        builder->appendLine(".valid = 1,");
+    }
     builder->blockEnd(false);
     builder->endOfStatement(true);
 }
 
+/**
+ * Const entries are matched by a chain of conditions on the key expressions, in the order
+ * in which they have to be tried: the order of the entries, except for LPM tables where
+ * longer prefixes are tried first. The matched entry is copied to a local value, so the
+ * rest of the table apply code is the same as for a lookup into a map.
+ */
+void EBPFTablePSA::emitInlineConstEntriesLookup(CodeBuilder *builder, cstring value) {
+    std::vector<const IR::Entry*> entries;
+    for (auto entry : table->container->getEntries()->entries)
+        entries.push_back(entry);
+
+    if (isLPMTable()) {
+        auto prefixLen = [this](const IR::Entry *entry) -> unsigned {
+            for (size_t index = 0; index < keyGenerator->keyElements.size(); index++) {
+                auto keyElement = keyGenerator->keyElements[index];
+                if (keyElement->matchType->path->name.name !=
+                    P4::P4CoreLibrary::instance.lpmMatch.name)
+                    continue;
+                auto k = entry->keys->components[index];
+                if (k->is<IR::DefaultExpression>())
+                    return 0;
+                if (auto km = k->to<IR::Mask>())
+                    return bitcount(km->right->to<IR::Constant>()->value);
+                return ::get(keyTypes, keyElement)->to<EBPFScalarType>()->widthInBits();
+            }
+            return 0;
+        };
+        std::stable_sort(entries.begin(), entries.end(),
+            [&prefixLen](const IR::Entry *a, const IR::Entry *b) {
+                return prefixLen(a) > prefixLen(b);
+            });
+    }
+
+    cstring constValueName = program->refMap->newName("const_value");
+    builder->emitIndent();
+    builder->appendLine("/* const entries are matched inline, no map lookup */");
+    builder->emitIndent();
+    builder->appendFormat("struct %s %s", valueTypeName.c_str(), constValueName.c_str());
+    builder->endOfStatement(true);
+
+    bool first = true;
+    for (auto entry : entries) {
+        builder->emitIndent();
+        if (!first)
+            builder->append("else ");
+        first = false;
+        builder->append("if (");
+        emitInlineEntryCondition(builder, entry);
+        builder->append(") ");
+        builder->blockStart();
+        auto entryName = program->refMap->newName("entry");
+        emitTableValue(builder, entry->action->to<IR::MethodCallExpression>(), entryName);
+        builder->emitIndent();
+        builder->appendFormat("%s = %s", constValueName.c_str(), entryName.c_str());
+        builder->endOfStatement(true);
+        builder->emitIndent();
+        builder->appendFormat("%s = &%s", value.c_str(), constValueName.c_str());
+        builder->endOfStatement(true);
+        builder->blockEnd(true);
+    }
+}
+
+void EBPFTablePSA::emitInlineEntryCondition(CodeBuilder *builder, const IR::Entry *entry) {
+    CodeGenInspector cg(program->refMap, program->typeMap);
+    cg.setBuilder(builder);
+
+    bool empty = true;
+    for (size_t index = 0; index < keyGenerator->keyElements.size(); index++) {
+        auto keyElement = keyGenerator->keyElements[index];
+        auto k = entry->keys->components[index];
+        if (k->is<IR::DefaultExpression>())
+            continue;
+        if (!empty)
+            builder->append(" && ");
+        empty = false;
+
+        builder->append("(");
+        if (auto km = k->to<IR::Mask>()) {
+            auto mask = km->right->to<IR::Constant>();
+            auto masked = new IR::Constant(km->left->type,
+                                           km->left->to<IR::Constant>()->value & mask->value);
+            builder->append("(");
+            codeGen->visit(keyElement->expression);
+            builder->append(" & ");
+            mask->apply(cg);
+            builder->append(") == ");
+            masked->apply(cg);
+        } else {
+            codeGen->visit(keyElement->expression);
+            builder->append(" == ");
+            k->apply(cg);
+        }
+        builder->append(")");
+    }
+
+    if (empty)
+        builder->append("1");
+}
+
+/**
+ * With table caching, the result of the tuple space search is stored in an LRU map keyed
+ * by the lookup key. Each cached result records the generation of the table it was
+ * computed from; the control plane bumps the generation on every write to the table,
+ * which invalidates all cached results at once. The generation is read before the search,
+ * so a result computed while the table is being modified is never considered valid.
+ */
+void EBPFTablePSA::emitLookup(CodeBuilder* builder, cstring key, cstring value) {
+    if (constEntriesInlined) {
+        emitInlineConstEntriesLookup(builder, value);
+        return;
+    }
+
+    if (arrayMapEnabled) {
+        cstring indexName = program->refMap->newName("key_index");
+        builder->emitIndent();
+        builder->appendLine("/* direct lookup, the key is the index in the array map */");
+        emitArrayMapIndex(builder, key, indexName);
+        builder->emitIndent();
+        builder->target->emitTableLookup(builder, instanceName, indexName, value);
+        builder->endOfStatement(true);
+        builder->emitIndent();
+        builder->appendFormat("if (%s != NULL && %s->valid == 0)", value.c_str(), value.c_str());
+        builder->newline();
+        builder->increaseIndent();
+        builder->emitIndent();
+        builder->appendFormat("%s = NULL", value.c_str());
+        builder->endOfStatement(true);
+        builder->decreaseIndent();
+        return;
+    }
+
+    if (!tableCacheEnabled) {
+        EBPFTable::emitLookup(builder, key, value);
+        return;
+    }
+
+    builder->appendFormat("struct %s *cached_value = NULL;", cacheValueTypeName.c_str());
+    builder->newline();
+    builder->emitIndent();
+    builder->appendLine("__u32 cache_generation_value = 0;");
+    builder->emitIndent();
+    builder->append("__u32 *cache_generation = ");
+    builder->target->emitTableLookup(builder, cacheGenerationMapName,
+                                     program->zeroKey, "");
+    builder->endOfStatement(true);
+    builder->emitIndent();
+    builder->append("if (cache_generation != NULL) ");
+    builder->blockStart();
+    builder->emitIndent();
+    builder->appendLine("cache_generation_value = *cache_generation;");
+    builder->emitIndent();
+    builder->target->emitTableLookup(builder, cacheMapName, key, "cached_value");
+    builder->endOfStatement(true);
+    builder->blockEnd(true);
+
+    builder->emitIndent();
+    builder->append("if (cache_generation != NULL && cached_value != NULL && "
+                    "cached_value->generation == cache_generation_value) ");
+    builder->blockStart();
+    builder->target->emitTraceMessage(builder, "Control: table cache hit");
+    builder->emitIndent();
+    builder->append("if (cached_value->hit != 0) ");
+    builder->blockStart();
+    builder->emitIndent();
+    builder->appendFormat("%s = &cached_value->value;", value.c_str());
+    builder->newline();
+    builder->blockEnd(true);
+    builder->blockEnd(false);
+    builder->append(" else ");
+    builder->blockStart();
+    builder->emitIndent();
+    EBPFTable::emitLookup(builder, key, value);
+
+    builder->emitIndent();
+    builder->append("if (cache_generation != NULL) ");
+    builder->blockStart();
+    builder->emitIndent();
+    builder->appendFormat("struct %s new_cached_value = {};", cacheValueTypeName.c_str());
+    builder->newline();
+    builder->emitIndent();
+    builder->appendLine("new_cached_value.generation = cache_generation_value;");
+    builder->emitIndent();
+    builder->appendFormat("if (%s != NULL) ", value.c_str());
+    builder->blockStart();
+    builder->emitIndent();
+    builder->appendLine("new_cached_value.hit = 1;");
+    builder->emitIndent();
+    builder->appendFormat("new_cached_value.value = *%s;", value.c_str());
+    builder->newline();
+    builder->blockEnd(true);
+    builder->emitIndent();
+    builder->target->emitTableUpdate(builder, cacheMapName, key, "new_cached_value");
+    builder->newline();
+    builder->blockEnd(true);
+    builder->blockEnd(true);
+}
+
 void EBPFTablePSA::emitLookupDefault(CodeBuilder* builder, cstring key, cstring value,
                                      cstring actionRunVariable) {
     if (implementation != nullptr) {
@@ -606,7 +928,7 @@ void EBPFTablePSA::emitTernaryConstEntriesInitializer(CodeBuilder *builder) {
     cstring valueMask = program->refMap->newName("value_mask");
     cstring nextMask = keyMasksNames[0];
     int noTupleId = -1;
-    emitValueMask(builder, valueMask, nextMask, noTupleId);
+    emitValueMask(builder, valueMask, nextMask, noTupleId, 0);
     builder->newline();
 
     builder->emitIndent();
@@ -629,7 +951,11 @@ void EBPFTablePSA::emitTernaryConstEntriesInitializer(CodeBuilder *builder) {
         if (entriesGroupedByPrefix.size() > i + 1) {
             nextMask = keyMasksNames[i + 1];
         }
-        emitValueMask(builder, valueMask, nextMask, tuple_id);
+        // Entries of a tuple are in the order of the const entries, so the first one
+        // has the highest priority of the tuple and tuples are chained by decreasing
+        // priority, as required by --ternary-priority-order.
+        emitValueMask(builder, valueMask, nextMask, tuple_id,
+                      getConstEntryPriority(samePrefixEntries.front()));
         builder->newline();
         emitKeysAndValues(builder, samePrefixEntries, keyNames, valueNames);
 
@@ -707,9 +1033,25 @@ void EBPFTablePSA::emitKeysAndValues(CodeBuilder *builder,
         // construct value
         auto *mce = entry->action->to<IR::MethodCallExpression>();
         emitTableValue(builder, mce, valueName.c_str());
+        builder->emitIndent();
+        builder->appendFormat("%s.priority = %u", valueName.c_str(),
+                              getConstEntryPriority(entry));
+        builder->endOfStatement(true);
     }
 }
 
+/**
+ * The first matching const entry wins, so the priority of an entry decreases
+ * with its position in the list; the last entry has priority 1.
+ */
+unsigned int EBPFTablePSA::getConstEntryPriority(const IR::Entry *entry) const {
+    const IR::EntriesList* entries = table->container->getEntries();
+    CHECK_NULL(entries);
+    auto it = std::find(entries->entries.begin(), entries->entries.end(), entry);
+    BUG_CHECK(it != entries->entries.end(), "%1%: not a const entry of %2%", entry, instanceName);
+    return entries->entries.end() - it;
+}
+
 void EBPFTablePSA::emitKeyMasks(CodeBuilder *builder,
                                 std::vector<std::vector<const IR::Entry *>> &entriesGrpedByPrefix,
                                 std::vector<cstring> &keyMasksNames) {
@@ -788,7 +1130,8 @@ void EBPFTablePSA::emitMaskForExactMatch(CodeBuilder *builder,
 }
 
 void EBPFTablePSA::emitValueMask(CodeBuilder *builder, const cstring valueMask,
-                                        const cstring nextMask, int tupleId) const {
+                                 const cstring nextMask, int tupleId,
+                                 unsigned int maxPriority) const {
     builder->emitIndent();
     builder->appendFormat("struct %s_mask %s = {0}", valueTypeName, valueMask);
     builder->endOfStatement(true);
@@ -796,6 +1139,11 @@ void EBPFTablePSA::emitValueMask(CodeBuilder *builder, const cstring valueMask,
     builder->emitIndent();
     builder->appendFormat("%s.tuple_id = %s", valueMask, cstring::to_cstring(tupleId));
     builder->endOfStatement(true);
+    if (program->options.orderTernaryMasks) {
+        builder->emitIndent();
+        builder->appendFormat("%s.max_priority = %u", valueMask, maxPriority);
+        builder->endOfStatement(true);
+    }
     builder->emitIndent();
     if (nextMask.isNullOrEmpty()) {
         builder->appendFormat("%s.has_next = 0", valueMask);
@@ -34,6 +34,24 @@ class EBPFTablePSA : public EBPFTable {
     const cstring addPrefixFunctionName = "add_prefix_and_entries";
     const cstring tuplesMapName = instanceName + "_tuples_map";
     const cstring prefixesMapName = instanceName + "_prefixes";
+    const cstring cacheMapName = instanceName + "_cache";
+    const cstring cacheGenerationMapName = instanceName + "_cache_generation";
+    const cstring cacheValueTypeName = valueTypeName + "_cache";
+    // Ternary lookups are cached when --table-caching is set and the table
+    // has no direct externs, which would be updated in the cached copy.
+    bool tableCacheEnabled = false;
+    // Exact tables keyed by a single narrow field are backed by an array map indexed
+    // by the key when --table-array-map-width allows it; see shouldUseArrayMap().
+    bool arrayMapEnabled = false;
+    unsigned int arrayMapKeyWidth = 0;
+    bool shouldUseArrayMap();
+    // Const entries of small tables are matched by generated code instead of a map lookup
+    // when --inline-const-entries allows it; see shouldInlineConstEntries().
+    bool constEntriesInlined = false;
+    bool shouldInlineConstEntries();
+    void emitInlineConstEntriesLookup(CodeBuilder *builder, cstring value);
+    void emitInlineEntryCondition(CodeBuilder *builder, const IR::Entry *entry);
+    void emitArrayMapIndex(CodeBuilder *builder, cstring keyName, cstring indexName) const;
 
  protected:
     ActionTranslationVisitor* createActionTranslationVisitor(
@@ -51,10 +69,11 @@ class EBPFTablePSA : public EBPFTable {
     void emitMapUpdateTraceMsg(CodeBuilder *builder, cstring mapName,
                                cstring returnCode) const;
     void emitValueMask(CodeBuilder *builder, cstring valueMask,
-                       cstring nextMask, int tupleId) const;
+                       cstring nextMask, int tupleId, unsigned int maxPriority) const;
     void emitKeyMasks(CodeBuilder *builder,
                       std::vector<std::vector<const IR::Entry *>> &entriesGrpedByPrefix,
                       std::vector<cstring> &keyMasksNames);
+    unsigned int getConstEntryPriority(const IR::Entry *entry) const;
     void emitKeysAndValues(CodeBuilder *builder,
                            std::vector<const IR::Entry *> &samePrefixEntries,
                            std::vector<cstring> &keyNames,
@@ -79,6 +98,7 @@ class EBPFTablePSA : public EBPFTable {
     void emitAction(CodeBuilder* builder, cstring valueName, cstring actionRunVariable) override;
     void emitInitializer(CodeBuilder* builder) override;
     void emitDirectValueTypes(CodeBuilder* builder) override;
+    void emitLookup(CodeBuilder* builder, cstring key, cstring value) override;
     void emitLookupDefault(CodeBuilder* builder, cstring key, cstring value,
                            cstring actionRunVariable) override;
     bool dropOnNoMatchingEntryFound() const override;
@@ -43,6 +43,16 @@ EBPFMeterPSA::EBPFMeterPSA(const EBPFProgram *program,
 
     auto typeExpr = di->arguments->at(isDirect ? 0 : 1)->expression->to<IR::Constant>();
     this->type = toType(typeExpr->asInt());
+
+    if (di->getAnnotation("per_cpu") != nullptr) {
+        if (isDirect) {
+            ::warning(ErrorType::WARN_UNSUPPORTED,
+                      "%1%: per-CPU mode is not supported for DirectMeter, ignoring", di);
+        } else {
+            isPerCpu = true;
+            localMapName = instanceName + "_local";
+        }
+    }
 }
 
 EBPFType * EBPFMeterPSA::getBaseValueType(P4::ReferenceMap* refMap) {
@@ -78,6 +88,16 @@ cstring EBPFMeterPSA::getBaseStructName(P4::ReferenceMap* refMap) {
     return valueBaseStructName;
 }
 
+cstring EBPFMeterPSA::getLocalStructName(P4::ReferenceMap* refMap) {
+    static cstring valueLocalStructName;
+
+    if (valueLocalStructName.isNullOrEmpty()) {
+        valueLocalStructName = refMap->newName("meter_local_value");
+    }
+
+    return valueLocalStructName;
+}
+
 cstring EBPFMeterPSA::getIndirectStructName() const {
     static cstring valueIndirectStructName;
 
@@ -142,6 +162,24 @@ void EBPFMeterPSA::emitValueStruct(CodeBuilder* builder, P4::ReferenceMap* refMa
     builder->emitIndent();
     getBaseValueType(refMap)->emit(builder);
 }
+void EBPFMeterPSA::emitLocalValueStruct(CodeBuilder* builder, P4::ReferenceMap* refMap) {
+    auto vec = IR::IndexedVector<IR::StructField>();
+    auto bits_64 = IR::Type_Bits::get(64, false);
+    // The configuration of the shared Meter that the tokens were borrowed under.
+    const std::initializer_list<cstring> fieldsNames = {"pbs_left",
+                                                        "cbs_left",
+                                                        "pir_period",
+                                                        "cir_period",
+                                                        "pbs",
+                                                        "cbs"};
+    for (auto fieldName : fieldsNames) {
+        vec.push_back(new IR::StructField(IR::ID(fieldName), bits_64));
+    }
+    auto localStructType = new IR::Type_Struct(IR::ID(getLocalStructName(refMap)), vec);
+    builder->emitIndent();
+    EBPFTypeFactory::instance->create(localStructType)->emit(builder);
+}
+
 void EBPFMeterPSA::emitValueType(CodeBuilder* builder) const {
     if (isDirect) {
         builder->emitIndent();
@@ -157,6 +195,12 @@ void EBPFMeterPSA::emitInstance(CodeBuilder *builder) const {
         builder->target->emitTableDeclSpinlock(builder, instanceName, TableHash,
                                                this->keyTypeName,
                                                "struct " + getIndirectStructName(), size);
+        if (isPerCpu) {
+            builder->target->emitTableDecl(builder, localMapName, TablePerCPUHash,
+                                           this->keyTypeName,
+                                           "struct " + getLocalStructName(program->refMap),
+                                           size);
+        }
     } else {
         ::error(ErrorType::ERR_UNEXPECTED, "Direct meter belongs to table "
                                            "and cannot have own instance");
@@ -175,7 +219,16 @@ void EBPFMeterPSA::emitExecute(CodeBuilder* builder, const P4::ExternMethod* met
         functionNameSuffix = "";
     }
 
-    if (type == BYTES) {
+    if (isPerCpu) {
+        cstring unit = type == BYTES ? "bytes" : "packets";
+        builder->appendFormat("meter_execute_%s_per_cpu%s(&%s, &%s, ", unit,
+                              functionNameSuffix, instanceName, localMapName);
+        if (type == BYTES)
+            builder->appendFormat("&%s, ", pipeline->lengthVar.c_str());
+        this->emitIndex(builder, method, translator);
+        builder->appendFormat(", &%s, %u", pipeline->timestampVar.c_str(),
+                              program->options.perCpuMeterBatch);
+    } else if (type == BYTES) {
         builder->appendFormat("meter_execute_bytes%s(&%s, &%s, ", functionNameSuffix,
                               instanceName,
                               pipeline->lengthVar.c_str());
@@ -470,4 +523,202 @@ cstring EBPFMeterPSA::meterExecuteFunc(bool trace, P4::ReferenceMap* refMap) {
     return meterExecuteFunc;
 }
 
+/**
+ * Per-CPU variant of meter_execute_color_aware(). Each CPU meters packets
+ * against its own token buckets (local), which borrow up to batch packets
+ * worth of tokens from the shared buckets (value) when they run short.
+ * The shared buckets are refilled exactly as by meter_execute(), so the lock
+ * is only taken once per batch. Tokens are moved but never created, hence the
+ * long-term rates are exact. However, a CPU may color a packet worse than the
+ * exact meter while other CPUs hold unused tokens, and since the local buckets
+ * are not capped by the burst sizes, a burst may exceed PBS or CBS by at most
+ * the tokens held by all CPUs: nr_cpus * batch * packet_len.
+ * The local buckets remember the rates and burst sizes they were filled under,
+ * so the tokens borrowed before the Meter is reconfigured are dropped.
+ */
+cstring EBPFMeterPSA::meterExecutePerCpuFunc(bool trace, P4::ReferenceMap* refMap) {
+    cstring meterExecuteFunc =
+            "static __always_inline\n"
+            "enum PSA_MeterColor_t meter_execute_per_cpu(%meter_struct% *value, "
+            "void *lock, %meter_local_struct% *local, "
+            "u32 *packet_len, u64 *time_ns, u32 batch, enum PSA_MeterColor_t color) {\n"
+            "    if (value == NULL || value->pir_period == 0) {\n"
+            "        // From P4Runtime spec. No value - return default GREEN.\n"
+            "%trace_msg_meter_no_value%"
+            "        return GREEN;\n"
+            "    }\n"
+            "    if (local == NULL) {\n"
+            "        return meter_execute_color_aware(value, lock, packet_len, time_ns, color);\n"
+            "    }\n"
+            "\n"
+            "    if (local->pir_period != value->pir_period || "
+            "local->cir_period != value->cir_period ||\n"
+            "        local->pbs != value->pbs || local->cbs != value->cbs) {\n"
+            "        local->pbs_left = 0;\n"
+            "        local->cbs_left = 0;\n"
+            "        local->pir_period = value->pir_period;\n"
+            "        local->cir_period = value->cir_period;\n"
+            "        local->pbs = value->pbs;\n"
+            "        local->cbs = value->cbs;\n"
+            "    }\n"
+            "\n"
+            "    if (local->pbs_left < *packet_len || local->cbs_left < *packet_len) {\n"
+            "        u64 delta_p, delta_c;\n"
+            "        u64 n_periods_p, n_periods_c, tokens_pbs, tokens_cbs;\n"
+            "        u64 quantum = (u64) *packet_len * batch;\n"
+            "        bpf_spin_lock(lock);\n"
+            "        delta_p = *time_ns - value->time_p;\n"
+            "        delta_c = *time_ns - value->time_c;\n"
+            "\n"
+            "        n_periods_p = delta_p / value->pir_period;\n"
+            "        n_periods_c = delta_c / value->cir_period;\n"
+            "\n"
+            "        value->time_p += n_periods_p * value->pir_period;\n"
+            "        value->time_c += n_periods_c * value->cir_period;\n"
+            "\n"
+            "        tokens_pbs = value->pbs_left + "
+            "n_periods_p * value->pir_unit_per_period;\n"
+            "        if (tokens_pbs > value->pbs) {\n"
+            "            tokens_pbs = value->pbs;\n"
+            "        }\n"
+            "        tokens_cbs = value->cbs_left + "
+            "n_periods_c * value->cir_unit_per_period;\n"
+            "        if (tokens_cbs > value->cbs) {\n"
+            "            tokens_cbs = value->cbs;\n"
+            "        }\n"
+            "\n"
+            "        if (local->pbs_left < *packet_len) {\n"
+            "            u64 borrowed = quantum < tokens_pbs ? quantum : tokens_pbs;\n"
+            "            local->pbs_left += borrowed;\n"
+            "            tokens_pbs -= borrowed;\n"
+            "        }\n"
+            "        if (local->cbs_left < *packet_len) {\n"
+            "            u64 borrowed = quantum < tokens_cbs ? quantum : tokens_cbs;\n"
+            "            local->cbs_left += borrowed;\n"
+            "            tokens_cbs -= borrowed;\n"
+            "        }\n"
+            "        value->pbs_left = tokens_pbs;\n"
+            "        value->cbs_left = tokens_cbs;\n"
+            "        bpf_spin_unlock(lock);\n"
+            "%trace_msg_meter_borrow%"
+            "    }\n"
+            "\n"
+            "    if ((color == RED) || (*packet_len > local->pbs_left)) {\n"
+            "%trace_msg_meter_red%"
+            "        return RED;\n"
+            "    }\n"
+            "\n"
+            "    if ((color == YELLOW) || (*packet_len > local->cbs_left)) {\n"
+            "        local->pbs_left -= *packet_len;\n"
+            "%trace_msg_meter_yellow%"
+            "        return YELLOW;\n"
+            "    }\n"
+            "\n"
+            "    local->pbs_left -= *packet_len;\n"
+            "    local->cbs_left -= *packet_len;\n"
+            "%trace_msg_meter_green%"
+            "    return GREEN;\n"
+            "}\n"
+            "\n"
+            "static __always_inline\n"
+            "%meter_local_struct% *meter_get_local(void *local_map, void *key) {\n"
+            "    %meter_local_struct% *local = BPF_MAP_LOOKUP_ELEM(*local_map, key);\n"
+            "    if (local == NULL) {\n"
+            "        %meter_local_struct% empty = {0};\n"
+            "        BPF_MAP_UPDATE_ELEM(*local_map, key, &empty, BPF_NOEXIST);\n"
+            "        local = BPF_MAP_LOOKUP_ELEM(*local_map, key);\n"
+            "    }\n"
+            "    return local;\n"
+            "}\n"
+            "\n"
+            "static __always_inline\n"
+            "enum PSA_MeterColor_t meter_execute_bytes_per_cpu_color_aware("
+            "void *map, void *local_map, u32 *packet_len, void *key, u64 *time_ns, "
+            "u32 batch, enum PSA_MeterColor_t color) {\n"
+            "%trace_msg_meter_execute_bytes%"
+            "    %meter_struct% *value = BPF_MAP_LOOKUP_ELEM(*map, key);\n"
+            "    return meter_execute_per_cpu(value, ((void *)value) + "
+            "sizeof(%meter_struct%), "
+            "meter_get_local(local_map, key), packet_len, time_ns, batch, color);\n"
+            "}\n"
+            "\n"
+            "static __always_inline\n"
+            "enum PSA_MeterColor_t meter_execute_bytes_per_cpu("
+            "void *map, void *local_map, u32 *packet_len, void *key, u64 *time_ns, "
+            "u32 batch) {\n"
+            "    return meter_execute_bytes_per_cpu_color_aware(map, local_map, packet_len, "
+            "key, time_ns, batch, GREEN);\n"
+            "}\n"
+            "\n"
+            "static __always_inline\n"
+            "enum PSA_MeterColor_t meter_execute_packets_per_cpu_color_aware("
+            "void *map, void *local_map, void *key, u64 *time_ns, "
+            "u32 batch, enum PSA_MeterColor_t color) {\n"
+            "%trace_msg_meter_execute_packets%"
+            "    u32 len = 1;\n"
+            "    %meter_struct% *value = BPF_MAP_LOOKUP_ELEM(*map, key);\n"
+            "    return meter_execute_per_cpu(value, ((void *)value) + "
+            "sizeof(%meter_struct%), "
+            "meter_get_local(local_map, key), &len, time_ns, batch, color);\n"
+            "}\n"
+            "\n"
+            "static __always_inline\n"
+            "enum PSA_MeterColor_t meter_execute_packets_per_cpu("
+            "void *map, void *local_map, void *key, u64 *time_ns, u32 batch) {\n"
+            "    return meter_execute_packets_per_cpu_color_aware(map, local_map, key, "
+            "time_ns, batch, GREEN);\n"
+            "}\n";
+
+    if (trace) {
+        meterExecuteFunc = meterExecuteFunc
+                .replace(cstring("%trace_msg_meter_green%"),
+                         "    bpf_trace_message(\""
+                         "Meter: GREEN\\n\");\n");
+        meterExecuteFunc = meterExecuteFunc
+                .replace(cstring("%trace_msg_meter_yellow%"),
+                         "        bpf_trace_message(\""
+                         "Meter: YELLOW\\n\");\n");
+        meterExecuteFunc = meterExecuteFunc
+                .replace(cstring("%trace_msg_meter_red%"),
+                         "        bpf_trace_message(\""
+                         "Meter: RED\\n\");\n");
+        meterExecuteFunc = meterExecuteFunc
+                .replace(cstring("%trace_msg_meter_no_value%"),
+                         "        bpf_trace_message(\"Meter: No meter value! "
+                         "Returning default GREEN\\n\");\n");
+        meterExecuteFunc = meterExecuteFunc
+                .replace(cstring("%trace_msg_meter_borrow%"),
+                         "        bpf_trace_message(\"Meter: borrowed tokens "
+                         "from the shared bucket\\n\");\n");
+        meterExecuteFunc = meterExecuteFunc
+                .replace(cstring("%trace_msg_meter_execute_bytes%"),
+                         "    bpf_trace_message(\"Meter: execute BYTES (per-CPU)\\n\");\n");
+        meterExecuteFunc = meterExecuteFunc
+                .replace(cstring("%trace_msg_meter_execute_packets%"),
+                         "    bpf_trace_message(\"Meter: execute PACKETS (per-CPU)\\n\");\n");
+    } else {
+        meterExecuteFunc = meterExecuteFunc.replace(cstring("%trace_msg_meter_green%"),
+                                                    "");
+        meterExecuteFunc = meterExecuteFunc.replace(cstring("%trace_msg_meter_yellow%"),
+                                                    "");
+        meterExecuteFunc = meterExecuteFunc.replace(cstring("%trace_msg_meter_red%"),
+                                                    "");
+        meterExecuteFunc = meterExecuteFunc.replace(cstring("%trace_msg_meter_no_value%"),
+                                                    "");
+        meterExecuteFunc = meterExecuteFunc.replace(cstring("%trace_msg_meter_borrow%"),
+                                                    "");
+        meterExecuteFunc = meterExecuteFunc.replace(cstring("%trace_msg_meter_execute_bytes%"),
+                                                    "");
+        meterExecuteFunc = meterExecuteFunc.replace(cstring("%trace_msg_meter_execute_packets%"),
+                                                    "");
+    }
+
+    meterExecuteFunc = meterExecuteFunc.replace(cstring("%meter_struct%"),
+                                                cstring("struct ") + getBaseStructName(refMap));
+    meterExecuteFunc = meterExecuteFunc.replace(cstring("%meter_local_struct%"),
+                                                cstring("struct ") + getLocalStructName(refMap));
+
+    return meterExecuteFunc;
+}
+
 }  // namespace EBPF
@@ -27,6 +27,7 @@ class EBPFMeterPSA : public EBPFTableBase {
     static EBPFType *getBaseValueType(P4::ReferenceMap* refMap);
     EBPFType *getIndirectValueType() const;
     static cstring getBaseStructName(P4::ReferenceMap* refMap);
+    static cstring getLocalStructName(P4::ReferenceMap* refMap);
     cstring getIndirectStructName() const;
 
     void emitIndex(CodeBuilder* builder, const P4::ExternMethod *method,
@@ -39,6 +40,8 @@ class EBPFMeterPSA : public EBPFTableBase {
     size_t size{};
     EBPFType *keyType{};
     bool isDirect;
+    // per-CPU token buckets of a @per_cpu meter
+    cstring localMapName;
 
  public:
     enum MeterType {
@@ -46,6 +49,9 @@ class EBPFMeterPSA : public EBPFTableBase {
         BYTES
     };
     MeterType type;
+    // Set by the @per_cpu annotation: packets are metered against per-CPU
+    // token buckets which borrow tokens in batches from the shared bucket.
+    bool isPerCpu = false;
 
     EBPFMeterPSA(const EBPFProgram* program, cstring instanceName,
                  const IR::Declaration_Instance* di,
@@ -55,6 +61,7 @@ class EBPFMeterPSA : public EBPFTableBase {
 
     void emitKeyType(CodeBuilder* builder) const;
     static void emitValueStruct(CodeBuilder* builder, P4::ReferenceMap* refMap);
+    static void emitLocalValueStruct(CodeBuilder* builder, P4::ReferenceMap* refMap);
     void emitValueType(CodeBuilder* builder) const;
     void emitSpinLockField(CodeBuilder* builder) const;
     void emitInstance(CodeBuilder* builder) const;
@@ -64,6 +71,7 @@ class EBPFMeterPSA : public EBPFTableBase {
                            cstring valuePtr) const;
 
     static cstring meterExecuteFunc(bool trace, P4::ReferenceMap* refMap);
+    static cstring meterExecutePerCpuFunc(bool trace, P4::ReferenceMap* refMap);
 };
 
 }  // namespace EBPF
@@ -51,6 +51,11 @@ PARSER.add_argument("-t", "--target", dest="target", default="test",
                     "default is test")
 PARSER.add_argument("-e", "--extern-file", dest="extern", default="",
                     help="Specify path additional file with C extern function definition")
+PARSER.add_argument("-a", dest="compiler_options", default=[], action="append",
+                    help="Pass this option string to the compiler")
+PARSER.add_argument("-w", dest="expected_warnings", default=[], action="append",
+                    help="Fail unless the compiler reports a warning "
+                    "containing this string")
 
 
 def import_from(module, name):
@@ -89,6 +94,8 @@ class Options(object):
         # Actual location of the test framework
         self.testdir = os.path.dirname(os.path.realpath(__file__))
         self.extern = ""                # Path to C file with extern definition
+        self.compilerOptions = []       # Additional options of the P4 compiler
+        self.expectedWarnings = []      # Strings expected in the compiler warnings
 
 
 def run_model(ebpf, stffile):
@@ -110,6 +117,20 @@ def run_model(ebpf, stffile):
     return result
 
 
+def check_warnings(options, outputs):
+    """ Check that the compiler reported each of the expected warnings """
+    stderr = ""
+    if os.path.isfile(outputs["stderr"]):
+        with open(outputs["stderr"]) as f:
+            stderr = f.read()
+    for warning in options.expectedWarnings:
+        if warning not in stderr:
+            report_err(outputs["stderr"],
+                       "Missing expected warning:", warning)
+            return FAILURE
+    return SUCCESS
+
+
 def run_test(options, argv):
     """ Define the test environment and compile the p4 target
         Optional: Run the generated model """
@@ -143,8 +164,11 @@ def run_test(options, argv):
     # If extern file is passed, --emit-externs flag is added by default to the p4 compiler
     if options.extern:
         argv.append("--emit-externs")
+    argv.extend(options.compilerOptions)
     # Compile the p4 file to the specified target
     result, expected_error = ebpf.compile_p4(argv)
+    if result == SUCCESS and not expected_error:
+        result = check_warnings(options, output)
 
     # Compile and run the generated output
     if result == SUCCESS and not expected_error:
@@ -180,6 +204,9 @@ if __name__ == '__main__':
     options.cleanupTmp = args.nocleanup
     options.target = args.target
     options.extern = args.extern
+    for compiler_option in args.compiler_options:
+        options.compilerOptions.extend(compiler_option.split())
+    options.expectedWarnings = args.expected_warnings
 
     # All args after '--' are intended for the p4 compiler
     argv = argv[1:]
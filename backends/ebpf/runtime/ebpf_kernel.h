@@ -51,9 +51,71 @@ limitations under the License.
 #ifdef CONTROL_PLANE // BEGIN EBPF USER SPACE DEFINITIONS
 
 #include <bpf/bpf.h> // bpf_obj_get/pin, bpf_map_update_elem
+#include <errno.h>
+
+#ifndef ENOTSUPP
+#define ENOTSUPP 524 // returned by kernels without batch operations for a map type
+#endif
+
+/* Index of the first entry to write one by one after a failed batch operation.
+ * Older kernels reject the batch commands with EINVAL and map types without
+ * batch support return ENOTSUPP or EOPNOTSUPP: the number of processed entries
+ * reported by the kernel is then meaningless and all entries are written again.
+ * It is only trusted for an error on an entry, which is retried to report it. */
+static inline __u32 bpf_user_map_batch_resume(int err, __u32 done, __u32 count) {
+    if (err == EINVAL || err == ENOTSUPP || err == EOPNOTSUPP || done >= count)
+        return 0;
+    return done;
+}
+
+/* Batch operations need Linux 5.6 and are not implemented by all map types
+ * (e.g. LPM tries), the remaining entries are then processed one by one.
+ * On return, *count is the number of processed entries. */
+static inline int bpf_user_map_update_batch(int fd, void *keys, size_t key_size,
+                                            void *values, size_t value_size,
+                                            __u32 *count, __u64 flags) {
+    DECLARE_LIBBPF_OPTS(bpf_map_batch_opts, opts, .elem_flags = flags);
+    __u32 done = *count;
+    int ret = bpf_map_update_batch(fd, keys, values, &done, &opts);
+    if (ret == 0)
+        return 0;
+    done = bpf_user_map_batch_resume(errno, done, *count);
+    for (__u32 i = done; i < *count; i++) {
+        ret = bpf_map_update_elem(fd, (char *) keys + i * key_size,
+                                  (char *) values + i * value_size, flags);
+        if (ret != 0) {
+            *count = i;
+            return ret;
+        }
+    }
+    return 0;
+}
+
+static inline int bpf_user_map_delete_batch(int fd, void *keys, size_t key_size,
+                                            __u32 *count) {
+    DECLARE_LIBBPF_OPTS(bpf_map_batch_opts, opts);
+    __u32 done = *count;
+    int ret = bpf_map_delete_batch(fd, keys, &done, &opts);
+    if (ret == 0)
+        return 0;
+    done = bpf_user_map_batch_resume(errno, done, *count);
+    for (__u32 i = done; i < *count; i++) {
+        ret = bpf_map_delete_elem(fd, (char *) keys + i * key_size);
+        if (ret != 0) {
+            *count = i;
+            return ret;
+        }
+    }
+    return 0;
+}
 
 #define BPF_USER_MAP_UPDATE_ELEM(index, key, value, flags)\
     bpf_map_update_elem(index, key, value, flags)
+#define BPF_USER_MAP_UPDATE_BATCH(index, keys, values, count, flags)\
+    bpf_user_map_update_batch(index, keys, sizeof(*(keys)), values, sizeof(*(values)), \
+                              count, flags)
+#define BPF_USER_MAP_DELETE_BATCH(index, keys, count)\
+    bpf_user_map_delete_batch(index, keys, sizeof(*(keys)), count)
 #define BPF_OBJ_PIN(table, name) bpf_obj_pin(table, name)
 #define BPF_OBJ_GET(name) bpf_obj_get(name)
 
@@ -135,6 +197,16 @@ struct bpf_elf_map SEC("maps") NAME = {          \
     .pinning     = 2,                  \
     .flags       = FLAGS,              \
 };
+/* The programs of a program array have to be inserted by the loader. */
+#define REGISTER_PROG_ARRAY(NAME, TYPE, MAX_ENTRIES, ...) \
+struct bpf_elf_map SEC("maps") NAME = {          \
+    .type        = TYPE,               \
+    .size_key    = sizeof(__u32),      \
+    .size_value  = sizeof(__u32),      \
+    .max_elem    = MAX_ENTRIES,        \
+    .pinning     = 2,                  \
+    .flags       = 0,                  \
+};
 #else
 #define REGISTER_TABLE(NAME, TYPE, KEY_TYPE, VALUE_TYPE, MAX_ENTRIES) \
 struct {                                 \
@@ -169,6 +241,17 @@ struct {                                 \
     __uint(pinning, LIBBPF_PIN_BY_NAME); \
     __array(values, struct INNER_NAME);  \
 } NAME SEC(".maps");
+/* libbpf inserts the programs listed as [INDEX] = &PROGRAM when loading the object. */
+#define REGISTER_PROG_ARRAY(NAME, TYPE, MAX_ENTRIES, ...) \
+struct {                                 \
+    __uint(type, TYPE);                  \
+    __uint(key_size, sizeof(__u32));     \
+    __uint(max_entries, MAX_ENTRIES);    \
+    __uint(pinning, LIBBPF_PIN_BY_NAME); \
+    __array(values, int (void *));       \
+} NAME SEC(".maps") = {                  \
+    .values = { __VA_ARGS__ },           \
+};
 #define REGISTER_TABLE_NO_KEY_TYPE(NAME, TYPE, KEY_SIZE, VALUE_TYPE, MAX_ENTRIES) \
 struct {                                 \
     __uint(type, TYPE);                  \
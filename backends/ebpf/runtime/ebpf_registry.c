@@ -136,6 +136,45 @@ int registry_update_table_id(int tbl_id, void *key, void *value, unsigned long l
     return bpf_map_update_elem(&tmp_tbl->bpf_map, key, tmp_tbl->key_size, value, tmp_tbl->value_size, flags);
 }
 
+int registry_update_table_batch_id(int tbl_id, void *keys, void *values,
+                                   unsigned int *count, unsigned long long flags) {
+    struct bpf_table *tmp_tbl = registry_lookup_table_id(tbl_id);
+    if (tmp_tbl == NULL) {
+        /* not found, return */
+        *count = 0;
+        return EXIT_FAILURE;
+    }
+    for (unsigned int i = 0; i < *count; i++) {
+        void *key = (char *) keys + i * tmp_tbl->key_size;
+        void *value = (char *) values + i * tmp_tbl->value_size;
+        int ret = bpf_map_update_elem(&tmp_tbl->bpf_map, key, tmp_tbl->key_size,
+                                      value, tmp_tbl->value_size, flags);
+        if (ret != EXIT_SUCCESS) {
+            *count = i;
+            return ret;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+int registry_delete_table_batch_id(int tbl_id, void *keys, unsigned int *count) {
+    struct bpf_table *tmp_tbl = registry_lookup_table_id(tbl_id);
+    if (tmp_tbl == NULL) {
+        /* not found, return */
+        *count = 0;
+        return EXIT_FAILURE;
+    }
+    for (unsigned int i = 0; i < *count; i++) {
+        void *key = (char *) keys + i * tmp_tbl->key_size;
+        int ret = bpf_map_delete_elem(tmp_tbl->bpf_map, key, tmp_tbl->key_size);
+        if (ret != EXIT_SUCCESS) {
+            *count = i;
+            return ret;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
 int registry_delete_table_elem(const char *name, void *key) {
     struct bpf_table *tmp_tbl = registry_lookup_table(name);
     if (tmp_tbl == NULL)
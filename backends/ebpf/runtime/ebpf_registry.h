@@ -115,6 +115,29 @@ int registry_update_table(const char *name, void *key, void *value, unsigned lon
  */
 int registry_update_table_id(int tbl_id, void *key, void *value, unsigned long long flags);
 
+/**
+ * @brief Insert an array of key/value pairs into the hashmap.
+ * @details Emulates the BPF_MAP_UPDATE_BATCH command: "keys" and "values" are
+ * arrays of *count elements of the key and value size of the table.
+ * The entries are inserted in order until one of them cannot be inserted.
+ * On return, *count is the number of inserted entries.
+ * This operation uses an integer as the key.
+ * @return EXIT_FAILURE if map cannot be found or an entry cannot be inserted.
+ */
+int registry_update_table_batch_id(int tbl_id, void *keys, void *values,
+                                   unsigned int *count, unsigned long long flags);
+
+/**
+ * @brief Delete an array of keys from the hashmap.
+ * @details Emulates the BPF_MAP_DELETE_BATCH command: "keys" is an array
+ * of *count elements of the key size of the table.
+ * The keys are deleted in order until one of them cannot be deleted.
+ * On return, *count is the number of deleted entries.
+ * This operation uses an integer as the key.
+ * @return EXIT_FAILURE if map cannot be found or a key cannot be deleted.
+ */
+int registry_delete_table_batch_id(int tbl_id, void *keys, unsigned int *count);
+
 /**
  * @brief Delete a key from the hashmap.
  * @details A safe wrapper function to delete an entry from a bpf map where
@@ -100,6 +100,10 @@ struct bpf_table tables[] = {
     registry_delete_table_elem(MAP_PATH"/"#table, key)
 #define BPF_USER_MAP_UPDATE_ELEM(index, key, value, flags)\
     registry_update_table_id(index, key, value, flags)
+#define BPF_USER_MAP_UPDATE_BATCH(index, keys, values, count, flags)\
+    registry_update_table_batch_id(index, keys, values, count, flags)
+#define BPF_USER_MAP_DELETE_BATCH(index, keys, count)\
+    registry_delete_table_batch_id(index, keys, count)
 #define BPF_OBJ_PIN(table, name) registry_add(table)
 #define BPF_OBJ_GET(name) registry_get_id(name)
 
@@ -66,6 +66,22 @@ void KernelSamplesTarget::emitUserTableUpdate(Util::SourceCodeBuilder* builder,
                           tblName.c_str(), key.c_str(), value.c_str());
 }
 
+void KernelSamplesTarget::emitUserTableUpdateBatch(Util::SourceCodeBuilder* builder,
+                                                   cstring tblName, cstring keys,
+                                                   cstring values, cstring count,
+                                                   cstring flags) const {
+    builder->appendFormat("BPF_USER_MAP_UPDATE_BATCH(%s, %s, %s, %s, %s);",
+                          tblName.c_str(), keys.c_str(), values.c_str(),
+                          count.c_str(), flags.c_str());
+}
+
+void KernelSamplesTarget::emitUserTableDeleteBatch(Util::SourceCodeBuilder* builder,
+                                                   cstring tblName, cstring keys,
+                                                   cstring count) const {
+    builder->appendFormat("BPF_USER_MAP_DELETE_BATCH(%s, %s, %s);",
+                          tblName.c_str(), keys.c_str(), count.c_str());
+}
+
 void KernelSamplesTarget::emitTableDecl(Util::SourceCodeBuilder* builder,
                                         cstring tblName, TableKind tableKind,
                                         cstring keyType, cstring valueType,
@@ -152,6 +168,33 @@ KernelSamplesTarget::emitMapInMapDecl(Util::SourceCodeBuilder *builder, cstring
     annotateTableWithBTF(builder, outerName, keyType, "__u32");
 }
 
+void KernelSamplesTarget::emitProgArrayDecl(Util::SourceCodeBuilder* builder,
+                                            cstring tblName,
+                                            const std::vector<cstring>& programs) const {
+    for (auto program : programs) {
+        if (program.isNullOrEmpty())
+            continue;
+        builder->appendFormat("int %s(SK_BUFF *);", program.c_str());
+        builder->newline();
+    }
+    builder->appendFormat("REGISTER_PROG_ARRAY(%s, %s, %d",
+                          tblName.c_str(), getBPFMapType(TableProgArray).c_str(),
+                          static_cast<unsigned>(programs.size()));
+    for (unsigned i = 0; i < programs.size(); i++) {
+        if (programs[i].isNullOrEmpty())
+            continue;
+        builder->appendFormat(", [%d] = &%s", i, programs[i].c_str());
+    }
+    builder->append(")");
+    builder->newline();
+}
+
+void KernelSamplesTarget::emitTailCall(Util::SourceCodeBuilder* builder, cstring contextVar,
+                                       cstring tblName, unsigned index) const {
+    builder->appendFormat("bpf_tail_call(%s, &%s, %d);",
+                          contextVar.c_str(), tblName.c_str(), index);
+}
+
 void KernelSamplesTarget::emitLicense(Util::SourceCodeBuilder* builder, cstring license) const {
     builder->emitIndent();
     builder->appendFormat("char _license[] SEC(\"license\") = \"%s\";", license.c_str());
@@ -225,6 +268,23 @@ void KernelSamplesTarget::annotateTableWithBTF(Util::SourceCodeBuilder* builder,
 
 //////////////////////////////////////////////////////////////
 
+void XdpTarget::emitResizeBuffer(Util::SourceCodeBuilder* builder,
+                                 cstring buffer, cstring offsetVar) const {
+    // bpf_xdp_adjust_head() moves the start of the packet, so growing
+    // the packet by N bytes means moving its start by -N bytes.
+    builder->appendFormat("bpf_xdp_adjust_head(%s, -(%s))",
+                          buffer, offsetVar);
+}
+
+void XdpTarget::emitMain(Util::SourceCodeBuilder* builder,
+                         cstring functionName,
+                         cstring argName) const {
+    builder->appendFormat("int %s(%s *%s)",
+                          functionName.c_str(), packetDescriptorType().c_str(), argName.c_str());
+}
+
+//////////////////////////////////////////////////////////////
+
 void TestTarget::emitIncludes(Util::SourceCodeBuilder* builder) const {
     builder->append("#include \"ebpf_test.h\"\n");
     builder->newline();
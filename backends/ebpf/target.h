@@ -17,6 +17,8 @@ limitations under the License.
 #ifndef _BACKENDS_EBPF_TARGET_H_
 #define _BACKENDS_EBPF_TARGET_H_
 
+#include <vector>
+
 #include "lib/cstring.h"
 #include "lib/error.h"
 #include "lib/sourceCodeBuilder.h"
@@ -31,10 +33,12 @@ enum TableKind {
     TableHash,
     TableArray,
     TablePerCPUArray,
+    TablePerCPUHash,
     TableProgArray,
     TableLPMTrie,  // longest prefix match trie
     TableHashLRU,
-    TableDevmap
+    TableDevmap,
+    TableDevmapHash
 };
 
 class Target {
@@ -57,6 +61,31 @@ class Target {
                                  cstring key, cstring value) const = 0;
     virtual void emitUserTableUpdate(Util::SourceCodeBuilder* builder, cstring tblName,
                                      cstring key, cstring value) const = 0;
+    // Batched updates from the control plane; keys and values are arrays and
+    // count points to the number of entries, set to the number of processed entries.
+    virtual void emitUserTableUpdateBatch(Util::SourceCodeBuilder* builder, cstring tblName,
+                                          cstring keys, cstring values, cstring count,
+                                          cstring flags) const {
+        (void) builder;
+        (void) tblName;
+        (void) keys;
+        (void) values;
+        (void) count;
+        (void) flags;
+        ::error(ErrorType::ERR_UNSUPPORTED,
+                "emitUserTableUpdateBatch is not supported on %1% target",
+                name);
+    }
+    virtual void emitUserTableDeleteBatch(Util::SourceCodeBuilder* builder, cstring tblName,
+                                          cstring keys, cstring count) const {
+        (void) builder;
+        (void) tblName;
+        (void) keys;
+        (void) count;
+        ::error(ErrorType::ERR_UNSUPPORTED,
+                "emitUserTableDeleteBatch is not supported on %1% target",
+                name);
+    }
     virtual void emitTableDecl(Util::SourceCodeBuilder* builder,
                                cstring tblName, TableKind tableKind,
                                cstring keyType, cstring valueType, unsigned size) const = 0;
@@ -94,6 +123,29 @@ class Target {
                 "emitMapInMapDecl is not supported on %1% target",
                 name);
     }
+    // Declares a program array holding at index i the function programs[i]
+    // (empty names leave the entry unset), taking a packet descriptor.
+    virtual void emitProgArrayDecl(Util::SourceCodeBuilder* builder, cstring tblName,
+                                   const std::vector<cstring>& programs) const {
+        (void) builder;
+        (void) tblName;
+        (void) programs;
+        ::error(ErrorType::ERR_UNSUPPORTED,
+                "emitProgArrayDecl is not supported on %1% target",
+                name);
+    }
+    // Jumps to the program at 'index' of the program array; the code following
+    // the tail call only runs if the jump failed.
+    virtual void emitTailCall(Util::SourceCodeBuilder* builder, cstring contextVar,
+                              cstring tblName, unsigned index) const {
+        (void) builder;
+        (void) contextVar;
+        (void) tblName;
+        (void) index;
+        ::error(ErrorType::ERR_UNSUPPORTED,
+                "emitTailCall is not supported on %1% target",
+                name);
+    }
     virtual void emitMain(Util::SourceCodeBuilder* builder,
                           cstring functionName,
                           cstring argName) const = 0;
@@ -136,6 +188,8 @@ class KernelSamplesTarget : public Target {
             return "BPF_MAP_TYPE_ARRAY";
         } else if (kind == TablePerCPUArray) {
             return "BPF_MAP_TYPE_PERCPU_ARRAY";
+        } else if (kind == TablePerCPUHash) {
+            return "BPF_MAP_TYPE_PERCPU_HASH";
         } else if (kind == TableLPMTrie) {
             return "BPF_MAP_TYPE_LPM_TRIE";
         } else if (kind == TableHashLRU) {
@@ -144,6 +198,8 @@ class KernelSamplesTarget : public Target {
             return "BPF_MAP_TYPE_PROG_ARRAY";
         } else if (kind == TableDevmap) {
             return "BPF_MAP_TYPE_DEVMAP";
+        } else if (kind == TableDevmapHash) {
+            return "BPF_MAP_TYPE_DEVMAP_HASH";
         }
         BUG("Unknown table kind");
     }
@@ -166,6 +222,11 @@ class KernelSamplesTarget : public Target {
                          cstring key, cstring value) const override;
     void emitUserTableUpdate(Util::SourceCodeBuilder* builder, cstring tblName,
                              cstring key, cstring value) const override;
+    void emitUserTableUpdateBatch(Util::SourceCodeBuilder* builder, cstring tblName,
+                                  cstring keys, cstring values, cstring count,
+                                  cstring flags) const override;
+    void emitUserTableDeleteBatch(Util::SourceCodeBuilder* builder, cstring tblName,
+                                  cstring keys, cstring count) const override;
     void emitTableDecl(Util::SourceCodeBuilder* builder,
                        cstring tblName, TableKind tableKind,
                        cstring keyType, cstring valueType, unsigned size) const override;
@@ -177,6 +238,10 @@ class KernelSamplesTarget : public Target {
                           cstring innerKeyType, cstring innerValueType, unsigned innerSize,
                           cstring outerName, TableKind outerTableKind,
                           cstring outerKeyType, unsigned outerSize) const override;
+    void emitProgArrayDecl(Util::SourceCodeBuilder* builder, cstring tblName,
+                           const std::vector<cstring>& programs) const override;
+    void emitTailCall(Util::SourceCodeBuilder* builder, cstring contextVar,
+                      cstring tblName, unsigned index) const override;
     void emitMain(Util::SourceCodeBuilder* builder,
                   cstring functionName,
                   cstring argName) const override;
@@ -198,6 +263,23 @@ class KernelSamplesTarget : public Target {
                               cstring keyType, cstring valueType) const;
 };
 
+// Represents a target that attaches the programs to the XDP hook.
+// It shares the map and helper definitions with the TC-based kernel target.
+class XdpTarget : public KernelSamplesTarget {
+ public:
+    explicit XdpTarget(bool emitTrace = false) : KernelSamplesTarget(emitTrace, "XDP") {}
+
+    void emitResizeBuffer(Util::SourceCodeBuilder* builder, cstring buffer,
+                          cstring offsetVar) const override;
+    void emitMain(Util::SourceCodeBuilder* builder,
+                  cstring functionName,
+                  cstring argName) const override;
+    cstring forwardReturnCode() const override { return "XDP_PASS"; }
+    cstring dropReturnCode() const override { return "XDP_DROP"; }
+    cstring abortReturnCode() const override { return "XDP_ABORTED"; }
+    cstring packetDescriptorType() const override { return "struct xdp_md"; }
+};
+
 // Represents a target compiled by bcc that uses the TC
 class BccTarget : public Target {
  public:
@@ -36,12 +36,48 @@ class eBPFCommand(object):
         self.extra = extra          # could also be "pcapng"
 
 
-def _generate_control_actions(cmds):
+def _generate_key(cmd, key_name):
+    """ Generates the assignments of the fields of the key of an "add"
+    command to the key structure key_name. """
+    generated = ""
+    for key_num, key_field in enumerate(cmd.match):
+        field = key_field[0].split('.')[1]
+        key_field_val = key_field[1]
+        # Support for LPM key
+        if isinstance(key_field_val, tuple):
+            generated += ("%s.prefixlen = (offsetof(struct %s_key, %s) - 4) * 8 + %s;\n\t"
+                          % (key_name, cmd.table, field, key_field_val[1]))
+            key_field_val = key_field_val[0]
+        generated += ("%s.%s = %s;\n\t"
+                      % (key_name, field, key_field_val))
+    return generated
+
+
+def _generate_value(cmd):
+    """ Generates the initializer of the value structure of a command. """
+    generated = "{\n\t\t"
+    if cmd.action[0] == "_NoAction":
+        generated += ".action = 0,\n\t\t"
+    else:
+        action_full_name = "{}_ACT_{}".format(cmd.table.upper(), cmd.action[0].upper())
+        generated += ".action = %s,\n\t\t" % action_full_name
+    generated += ".u = {.%s = {" % cmd.action[0]
+    for val_num, val_field in enumerate(cmd.action[1]):
+        generated += "%s," % val_field[1]
+    generated += "}},\n\t"
+    generated += "}"
+    return generated
+
+
+def _generate_control_actions(cmds, first_index=0):
     """ Generates the actual control plane commands.
     This function inserts C code for all the "add" commands that have
     been parsed. """
     generated = ""
-    for index, cmd in enumerate(cmds):
+    for index, cmd in enumerate(cmds, first_index):
+        if cmd.a_type == "remove":
+            # only supported with the batch functions
+            continue
         key_name = "key_%s%d" % (cmd.table, index)
         value_name = "value_%s%d" % (cmd.table, index)
         if cmd.a_type == "setdefault":
@@ -50,34 +86,15 @@ def _generate_control_actions(cmds):
         else:
             generated += "struct %s_key %s = {};\n\t" % (cmd.table, key_name)
             tbl_name = cmd.table
-            for key_num, key_field in enumerate(cmd.match):
-                field = key_field[0].split('.')[1]
-                key_field_val = key_field[1]
-                # Support for LPM key
-                if isinstance(key_field_val, tuple):
-                    generated += ("%s.prefixlen = (offsetof(struct %s_key, %s) - 4) * 8 + %s;\n\t"
-                                  % (key_name, cmd.table, field, key_field_val[1]))
-                    key_field_val = key_field_val[0]
-                generated += ("%s.%s = %s;\n\t"
-                              % (key_name, field, key_field_val))
+            generated += _generate_key(cmd, key_name)
         generated += ("tableFileDescriptor = "
                       "BPF_OBJ_GET(MAP_PATH \"/%s\");\n\t" %
                       tbl_name)
         generated += ("if (tableFileDescriptor < 0) {"
                       "fprintf(stderr, \"map %s not loaded\");"
                       " exit(1); }\n\t" % tbl_name)
-        generated += ("struct %s_value %s = {\n\t\t" % (
-            cmd.table, value_name))
-        if cmd.action[0] == "_NoAction":
-            generated += ".action = 0,\n\t\t"
-        else:
-            action_full_name = "{}_ACT_{}".format(cmd.table.upper(), cmd.action[0].upper())
-            generated += ".action = %s,\n\t\t" % action_full_name
-        generated += ".u = {.%s = {" % cmd.action[0]
-        for val_num, val_field in enumerate(cmd.action[1]):
-            generated += "%s," % val_field[1]
-        generated += "}},\n\t"
-        generated += "};\n\t"
+        generated += ("struct %s_value %s = %s;\n\t" % (
+            cmd.table, value_name, _generate_value(cmd)))
         generated += ("ok = BPF_USER_MAP_UPDATE_ELEM"
                       "(tableFileDescriptor, &%s, &%s, BPF_ANY);\n\t"
                       % (key_name, value_name))
@@ -86,11 +103,58 @@ def _generate_control_actions(cmds):
     return generated
 
 
-def create_table_file(actions, tmpdir, file_name):
+def _generate_batch_control_actions(cmds):
+    """ Generates the control plane commands using the batch functions
+    generated with --emit-table-batch-api. Consecutive "add" commands on a
+    table are written with a single <table>_add_entries call, and
+    "remove all" deletes all entries added so far with <table>_delete_entries. """
+    generated = ""
+    batches = []
+    index = 0
+    while index < len(cmds):
+        cmd = cmds[index]
+        if cmd.a_type == "remove":
+            for table, keys_name, count in batches:
+                generated += "count = %d;\n\t" % count
+                generated += "ok = %s_delete_entries(%s, &count);\n\t" % (table, keys_name)
+                generated += ("if (ok != 0 || count != %d) { perror(\"Could not delete in %s\");"
+                              "exit(1); }\n\t" % (count, table))
+            batches = []
+            index += 1
+            continue
+        if cmd.a_type != "add":
+            generated += _generate_control_actions([cmd], index)
+            index += 1
+            continue
+        batch = [cmd]
+        while (index + len(batch) < len(cmds) and cmds[index + len(batch)].a_type == "add"
+               and cmds[index + len(batch)].table == cmd.table):
+            batch.append(cmds[index + len(batch)])
+        keys_name = "keys_%s%d" % (cmd.table, index)
+        values_name = "values_%s%d" % (cmd.table, index)
+        generated += "struct %s_key %s[%d] = {};\n\t" % (cmd.table, keys_name, len(batch))
+        generated += "struct %s_value %s[%d] = {\n\t" % (cmd.table, values_name, len(batch))
+        for entry in batch:
+            generated += "%s,\n\t" % _generate_value(entry)
+        generated += "};\n\t"
+        for entry_index, entry in enumerate(batch):
+            generated += _generate_key(entry, "%s[%d]" % (keys_name, entry_index))
+        generated += "count = %d;\n\t" % len(batch)
+        generated += ("ok = %s_add_entries(%s, %s, &count);\n\t"
+                      % (cmd.table, keys_name, values_name))
+        generated += ("if (ok != 0 || count != %d) { perror(\"Could not write in %s\");"
+                      "exit(1); }\n\t" % (len(batch), cmd.table))
+        batches.append((cmd.table, keys_name, len(batch)))
+        index += len(batch)
+    return generated
+
+
+def create_table_file(actions, tmpdir, file_name, batch=False):
     """ Create the control plane file.
     The control commands are provided by the stf parser.
     This generated file is required by ebpf_runtime.c to initialize
-    the control plane. """
+    the control plane. With batch, the tables are written with the
+    batch functions of the program. """
     err = ""
     try:
         with open(tmpdir + "/" + file_name, "w+") as control_file:
@@ -100,7 +164,11 @@ def create_table_file(actions, tmpdir, file_name):
             control_file.write("\n\t")
             control_file.write("int ok;\n\t")
             control_file.write("int tableFileDescriptor;\n\t")
-            generated_cmds = _generate_control_actions(actions)
+            if batch:
+                control_file.write("u32 count;\n\t")
+                generated_cmds = _generate_batch_control_actions(actions)
+            else:
+                generated_cmds = _generate_control_actions(actions)
             control_file.write(generated_cmds)
             control_file.write("}\n")
     except OSError as e:
@@ -137,6 +205,8 @@ def parse_stf_file(raw_stf):
                 priority=stf_entry[2], match=stf_entry[3],
                 action=stf_entry[4], extra=stf_entry[5])
             cmds.append(cmd)
+        elif stf_entry[0] == "remove":
+            cmds.append(eBPFCommand(a_type=stf_entry[0], table=None, action=None))
         elif stf_entry[0] == "setdefault":
             cmd = eBPFCommand(
                 a_type=stf_entry[0], table=stf_entry[1], action=stf_entry[2])
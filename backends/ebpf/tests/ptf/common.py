@@ -46,12 +46,26 @@ PIPELINE_MAPS_MOUNT_PATH = "{}/maps".format(TEST_PIPELINE_MOUNT_PATH)
 
 
 def xdp2tc_head_not_supported(cls):
-    if cls.xdp2tc_mode(cls) == 'head':
+    if cls.xdp2tc_mode(cls) == 'head' and not cls.is_xdp_test(cls):
         cls.skip = True
         cls.skip_reason = "not supported for xdp2tc=head"
     return cls
 
 
+def tc_only(cls):
+    if cls.is_xdp_test(cls):
+        cls.skip = True
+        cls.skip_reason = "not supported by XDP"
+    return cls
+
+
+def xdp_only(cls):
+    if not cls.is_xdp_test(cls):
+        cls.skip = True
+        cls.skip_reason = "only for XDP"
+    return cls
+
+
 class P4EbpfTest(BaseTest):
     """
     Generates BPF bytecode from a P4 program and runs a PTF test.
@@ -61,6 +75,7 @@ class P4EbpfTest(BaseTest):
     skip_reason = ''
     switch_ns = 'test'
     p4_file_path = ""
+    p4c_additional_args = ""
 
     def setUp(self):
         super(P4EbpfTest, self).setUp()
@@ -81,8 +96,12 @@ class P4EbpfTest(BaseTest):
         p4args = "--Wdisable=unused --max-ternary-masks 3"
         if self.is_trace_logs_enabled():
             p4args += " --trace"
+        if self.p4c_additional_args:
+            p4args += " " + self.p4c_additional_args
 
-        if "xdp2tc" in testutils.test_params_get():
+        if self.is_xdp_test():
+            p4args += " --xdp"
+        elif "xdp2tc" in testutils.test_params_get():
             p4args += " --xdp2tc=" + self.xdp2tc_mode()
 
         logger.info("P4ARGS=" + p4args)
@@ -150,6 +169,11 @@ class P4EbpfTest(BaseTest):
         value = [format(int(v, 0), '02x') for v in json.loads(stdout)['value']]
         return ' '.join(value)
 
+    def update_map(self, name, key, value):
+        cmd = "bpftool map update pinned {}/{} key {} value {}".format(PIPELINE_MAPS_MOUNT_PATH, name,
+                                                                       key, value)
+        self.exec_ns_cmd(cmd, "Failed to update map {}".format(name))
+
     def verify_map_entry(self, name, key, expected_value, mask=None):
         value = self.read_map(name, key)
 
@@ -172,6 +196,9 @@ class P4EbpfTest(BaseTest):
     def xdp2tc_mode(self):
         return testutils.test_param_get('xdp2tc')
 
+    def is_xdp_test(self):
+        return testutils.test_param_get('xdp') == 'True'
+
     def is_trace_logs_enabled(self):
         return testutils.test_param_get('trace') == 'True'
 
@@ -372,3 +372,48 @@ class DirectAndCounterMeterPSATest(P4EbpfTest):
         self.verify_map_entry(name="ingress_tbl_fwd", key="hex 04 00 00 00",
                               expected_value=expected_value,
                               mask=get_meter_value_mask())
+
+
+class PerCpuMeterPSATest(P4EbpfTest):
+    """
+    Test Meter with the @per_cpu annotation. Type BYTES.
+    Verify that packets get the same colors as with the exact Meter
+    and that tokens are borrowed from the shared bucket in batches.
+    """
+
+    p4_file_path = "p4testdata/meters-per-cpu.p4"
+
+    def runTest(self):
+        pkt = testutils.simple_ip_packet()
+
+        # cir, pir -> 1 byte/s, so that no tokens are added during the test
+        # cbs, pbs -> 50 B, 100 B packet is RED (dropped)
+        self.meter_update(name="ingress_meter1", index=0,
+                          pir=1, pbs=50, cir=1, cbs=50)
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_no_packet(self, pkt, PORT1)
+
+        # cbs, pbs -> 5000 B, 100 B packets are GREEN
+        self.meter_update(name="ingress_meter1", index=0,
+                          pir=1, pbs=5000, cir=1, cbs=5000)
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_packet(self, pkt, PORT1)
+        # The per-CPU bucket borrows 16 (default batch) * 100 B = 1600 B,
+        # expecting pbs_left, cbs_left 5000 B - 1600 B = 3400 B
+        meter_value = build_meter_value(pir=1, cir=1, pbs=5000,
+                                        pbs_left=3400, cbs=5000, cbs_left=3400)
+        self.verify_map_entry(name="ingress_meter1", key="hex 00",
+                              expected_value=meter_value, mask=get_meter_value_mask())
+
+        for i in range(0, 9):
+            testutils.send_packet(self, PORT0, pkt)
+            testutils.verify_packet(self, pkt, PORT1)
+
+        # The per-CPU bucket still holds 600 B borrowed under the old configuration.
+        # cbs, pbs -> 150 B, they are dropped, so only one 100 B packet is GREEN
+        self.meter_update(name="ingress_meter1", index=0,
+                          pir=1, pbs=150, cir=1, cbs=150)
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_packet(self, pkt, PORT1)
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_no_packet(self, pkt, PORT1)
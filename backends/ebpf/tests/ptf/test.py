@@ -46,6 +46,33 @@ class SimpleForwardingPSATest(P4EbpfTest):
         testutils.verify_packet(self, pkt, PORT2)
 
 
+@xdp_only
+class XdpRedirectPSATest(P4EbpfTest):
+    """
+    Unicast packets leave XDP through the tx_port devmap hash, keyed by the
+    interface index of the egress port.
+    """
+
+    p4_file_path = "p4testdata/simple-fwd.p4"
+
+    def runTest(self):
+        _, stdout, _ = self.exec_ns_cmd("bpftool -j map show pinned {}/tx_port".format(
+            PIPELINE_MAPS_MOUNT_PATH), "Failed to read map tx_port")
+        self.assertEqual(json.loads(stdout)['type'], "devmap_hash")
+
+        pkt = testutils.simple_ip_packet()
+        for port in [PORT1, PORT2, PORT0]:
+            # interface indexes of the ports start at 4
+            self.table_set_default(table="ingress_tbl_fwd", action=1, data=[port + 4])
+            testutils.send_packet(self, PORT0, pkt)
+            testutils.verify_packet(self, pkt, port)
+
+        # no tx_port entry for this interface index
+        self.table_set_default(table="ingress_tbl_fwd", action=1, data=[1000])
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_no_other_packets(self)
+
+
 class PSAResubmitTest(P4EbpfTest):
 
     p4_file_path = "p4testdata/resubmit.p4"
@@ -74,6 +101,7 @@ class SimpleTunnelingPSATest(P4EbpfTest):
         testutils.verify_packet(self, pkt, PORT1)
 
 
+@tc_only
 class PSACloneI2E(P4EbpfTest):
 
     p4_file_path = "p4testdata/clone-i2e.p4"
@@ -116,6 +144,7 @@ class EgressTrafficManagerDropPSATest(P4EbpfTest):
         testutils.verify_no_other_packets(self)
 
 
+@tc_only
 class EgressTrafficManagerClonePSATest(P4EbpfTest):
     """
     1. Send packet to interface PORT1 (bpf ifindex = 5) with destination MAC address equals to aa:bb:cc:dd:ee:ff.
@@ -145,6 +174,7 @@ class EgressTrafficManagerClonePSATest(P4EbpfTest):
         super(EgressTrafficManagerClonePSATest, self).tearDown()
 
 
+@tc_only
 @xdp2tc_head_not_supported
 class EgressTrafficManagerRecirculatePSATest(P4EbpfTest):
     """
@@ -251,6 +281,62 @@ class ConstEntryPSATest(P4EbpfTest):
         testutils.verify_packet(self, pkt, PORT1)
 
 
+class TableArrayMapPSATest(P4EbpfTest):
+    """
+    Exact table on an 8-bit field backed by an array map. Slots without an
+    entry are misses and run the default action.
+    """
+
+    p4_file_path = "p4testdata/table-array-map.p4"
+    p4c_additional_args = "--table-array-map-width 8"
+
+    def runTest(self):
+        pkt = testutils.simple_ip_packet(ip_tos=0x10)
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_packet(self, pkt, PORT1)
+
+        pkt = testutils.simple_ip_packet(ip_tos=0x20)
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_packet(self, pkt, PORT2)
+
+        # absent keys, including the first slot of the array
+        for tos in [0x30, 0x00, 0xff]:
+            pkt = testutils.simple_ip_packet(ip_tos=tos)
+            testutils.send_packet(self, PORT0, pkt)
+            testutils.verify_no_other_packets(self)
+
+
+@tc_only
+class ControlStagesPSATest(P4EbpfTest):
+    """
+    Ingress control split into stages chained with tail calls. The metadata
+    set by the tables and the local variable holding the source MAC address
+    are read in later stages, which swap the MAC addresses and forward.
+    """
+
+    p4_file_path = "p4testdata/control-stages.p4"
+    p4c_additional_args = "--max-stage-insns 50"
+
+    def runTest(self):
+        with open(os.path.splitext(self.test_prog_image)[0] + ".c") as f:
+            source = f.read()
+        self.assertIn("classifier/tc-ingress-stage1", source)
+        self.assertIn("classifier/tc-ingress-stage2", source)
+
+        for tos, port in [(0x10, PORT1), (0x20, PORT2)]:
+            pkt = testutils.simple_ip_packet(eth_dst='00:11:22:33:44:55', eth_src='55:44:33:22:11:00',
+                                             ip_tos=tos)
+            testutils.send_packet(self, PORT0, pkt)
+            pkt[Ether].dst = '55:44:33:22:11:00'
+            pkt[Ether].src = '00:11:22:33:44:55'
+            testutils.verify_packet(self, pkt, port)
+
+        # no class, dropped by the last stage
+        pkt = testutils.simple_ip_packet(ip_tos=0x30)
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_no_other_packets(self)
+
+
 class ConstEntryAndActionPSATest(P4EbpfTest):
 
     p4_file_path = "p4testdata/const-entry-and-action.p4"
@@ -274,6 +360,50 @@ class ConstEntryAndActionPSATest(P4EbpfTest):
         testutils.verify_packet(self, pkt, PORT0)
 
 
+class ConstEntryMatchOrderPSATest(P4EbpfTest):
+    """
+    Overlapping const entries of ternary and LPM tables, looked up in BPF maps.
+    """
+
+    p4_file_path = "p4testdata/const-entry-inline.p4"
+
+    def runTest(self):
+        # ternary: the first matching entry wins
+        pkt = testutils.simple_ip_packet(ip_dst="10.0.0.1")
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_packet(self, pkt, PORT1)
+        pkt = testutils.simple_ip_packet(ip_dst="10.0.0.2")
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_packet(self, pkt, PORT2)
+        pkt = testutils.simple_ip_packet(ip_dst="11.0.0.1")
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_packet(self, pkt, PORT2)
+        pkt = testutils.simple_ip_packet(ip_dst="12.0.0.1")
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_no_other_packets(self)
+
+        # LPM: the longest matching prefix wins
+        for src, dmac in [("12.12.12.1", "00:00:00:00:00:18"),
+                          ("12.12.1.1", "00:00:00:00:00:10"),
+                          ("12.1.1.1", "00:00:00:00:00:08")]:
+            pkt = testutils.simple_ip_packet(ip_src=src, ip_dst="10.0.0.1")
+            testutils.send_packet(self, PORT0, pkt)
+            pkt[Ether].dst = dmac
+            testutils.verify_packet(self, pkt, PORT1)
+        pkt = testutils.simple_ip_packet(ip_src="13.1.1.1", ip_dst="10.0.0.1")
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_packet(self, pkt, PORT1)
+
+
+class InlineConstEntryMatchOrderPSATest(ConstEntryMatchOrderPSATest):
+    """
+    Same as ConstEntryMatchOrderPSATest, with the const entries matched in
+    generated code instead of BPF maps.
+    """
+
+    p4c_additional_args = "--inline-const-entries 4"
+
+
 class BridgedMetadataPSATest(P4EbpfTest):
 
     p4_file_path = "p4testdata/bridged-metadata.p4"
@@ -563,6 +693,67 @@ class PSATernaryTest(P4EbpfTest):
         testutils.verify_packet(self, pkt, PORT1)
 
 
+class TableCachingPSATest(P4EbpfTest):
+    """
+    Test the lookup cache of ternary tables. A cached result is used
+    until the control plane increments the generation of the table.
+    """
+
+    p4_file_path = "p4testdata/psa-ternary.p4"
+    p4c_additional_args = "--table-caching"
+
+    def runTest(self):
+        pkt = Ether(bytes(testutils.simple_udp_packet(ip_src='1.2.3.4', ip_dst='192.168.2.1')))
+        exp_pkt = pkt.copy()
+        exp_pkt[IP].src = '17.17.17.17'
+
+        # The first packet runs the tuple space search and fills the cache
+        self.table_add(table="ingress_tbl_ternary_0", key=["1.2.3.4^0xffffff00"], action=0, priority=1)
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_packet(self, exp_pkt, PORT1)
+
+        # A better entry is not used as long as the cached result is valid
+        self.table_add(table="ingress_tbl_ternary_0", key=["1.2.3.4^0xffff00ff"], action=1, priority=10)
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_packet(self, exp_pkt, PORT1)
+
+        # Bumping the generation invalidates the cache, NoAction is used now
+        self.update_map(name="ingress_tbl_ternary_0_cache_generation",
+                        key="hex 00 00 00 00", value="hex 01 00 00 00")
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_packet(self, pkt, PORT1)
+
+
+class TernaryPriorityOrderPSATest(P4EbpfTest):
+    """
+    Test that the tuple space search returns the entry with the highest
+    priority among several masks when it may stop early. psabpf-ctl does
+    not set max_priority, so the whole chain of masks is searched.
+    """
+
+    p4_file_path = "p4testdata/psa-ternary.p4"
+    p4c_additional_args = "--ternary-priority-order"
+
+    def runTest(self):
+        # action 0 sets ipv4.srcAddr to 17.17.17.17, action 1 is NoAction
+        self.table_add(table="ingress_tbl_ternary_0", key=["1.0.0.0^0xff000000"], action=1, priority=1)
+        self.table_add(table="ingress_tbl_ternary_0", key=["1.2.0.0^0xffff0000"], action=0, priority=5)
+        self.table_add(table="ingress_tbl_ternary_0", key=["1.2.3.0^0xffffff00"], action=1, priority=3)
+
+        for src, changed in [("1.2.3.4", True), ("1.2.9.9", True), ("1.9.9.9", False)]:
+            pkt = Ether(bytes(testutils.simple_udp_packet(ip_src=src, ip_dst='192.168.2.1')))
+            exp_pkt = pkt.copy()
+            if changed:
+                exp_pkt[IP].src = '17.17.17.17'
+            testutils.send_packet(self, PORT0, pkt)
+            testutils.verify_packet(self, exp_pkt, PORT1)
+
+        self.table_add(table="ingress_tbl_ternary_0", key=["1.2.3.4^0xffffffff"], action=1, priority=10)
+        pkt = Ether(bytes(testutils.simple_udp_packet(ip_src='1.2.3.4', ip_dst='192.168.2.1')))
+        testutils.send_packet(self, PORT0, pkt)
+        testutils.verify_packet(self, pkt, PORT1)
+
+
 class ActionDefaultTernaryPSATest(P4EbpfTest):
 
     p4_file_path = "p4testdata/action-default-ternary.p4"
@@ -592,3 +783,12 @@ class ConstEntryTernaryPSATest(P4EbpfTest):
         pkt[IP].dst = 0x11993355  # mask is 0xFF00FFFF
         testutils.send_packet(self, PORT0, pkt)
         testutils.verify_packet(self, pkt, PORT1)
+
+
+class ConstEntryTernaryPriorityOrderPSATest(ConstEntryTernaryPSATest):
+    """
+    The same test, with the masks of the const entries chained by the compiler
+    in decreasing order of their max_priority.
+    """
+
+    p4c_additional_args = "--ternary-priority-order"
@@ -140,6 +140,8 @@ TRACE_LOGS="False"
 if [ ! -z "$BPF_HOOK" ]; then
   if [ "$BPF_HOOK" == "tc" ]; then
     XDP=( "False" )
+  elif [ "$BPF_HOOK" == "xdp" ]; then
+    XDP=( "True" )
   else
     echo "Wrong --bpf-hook value provided; running script for both hooks."
   fi
@@ -164,17 +166,22 @@ if [ ! -z "$TRACE_LOGS_ARGS" ]; then
 fi
 
 TEST_CASE=$@
-xdp_enabled="False"
-
-for xdp2tc_mode in "${XDP2TC_MODE[@]}" ; do
-  TEST_PARAMS='interfaces="'"$interface_list"'";namespace="switch";trace="'"$TRACE_LOGS"'"'
-  TEST_PARAMS+=";xdp2tc='$xdp2tc_mode'"
-  # Start tests
-  ptf \
-    --test-dir ptf/ \
-    --test-params="$TEST_PARAMS" \
-    --interface 0@s1-eth0 --interface 1@s1-eth1 --interface 2@s1-eth2 --interface 3@s1-eth3 \
-    --interface 4@s1-eth4 --interface 5@s1-eth5 $TEST_CASE
-  exit_on_error
-  rm -rf ptf_out
+
+for xdp_enabled in "${XDP[@]}" ; do
+  for xdp2tc_mode in "${XDP2TC_MODE[@]}" ; do
+    TEST_PARAMS='interfaces="'"$interface_list"'";namespace="switch";trace="'"$TRACE_LOGS"'"'
+    TEST_PARAMS+=";xdp2tc='$xdp2tc_mode';xdp='$xdp_enabled'"
+    # Start tests
+    ptf \
+      --test-dir ptf/ \
+      --test-params="$TEST_PARAMS" \
+      --interface 0@s1-eth0 --interface 1@s1-eth1 --interface 2@s1-eth2 --interface 3@s1-eth3 \
+      --interface 4@s1-eth4 --interface 5@s1-eth5 $TEST_CASE
+    exit_on_error
+    rm -rf ptf_out
+    # XDP2TC modes do not apply to the XDP mode
+    if [ "$xdp_enabled" == "True" ]; then
+      break
+    fi
+  done
 done
@@ -112,10 +112,10 @@ MidEnd::MidEnd(CompilerOptions& options, std::ostream* outStream) {
         new P4::MoveDeclarations(),  // more may have been introduced
         new P4::ConstantFolding(&refMap, &typeMap),
         new P4::GlobalCopyPropagation(&refMap, &typeMap),
-        new PassRepeated({
+        (new PassRepeated({
             new P4::LocalCopyPropagation(&refMap, &typeMap),
             new P4::ConstantFolding(&refMap, &typeMap),
-        }),
+        }))->setSkipConverged(),
         new P4::StrengthReduction(&refMap, &typeMap),
         new P4::MoveDeclarations(),  // more may have been introduced
         new P4::SimplifyControlFlow(&refMap, &typeMap),
@@ -37,6 +37,8 @@ if __name__ == "__main__":
     # Switch test directory based on path to run-ubpf-test.py
     options.testdir = os.path.dirname(os.path.realpath(__file__))
     options.extern = args.extern
+    for compiler_option in args.compiler_options:
+        options.compilerOptions.extend(compiler_option.split())
 
     # All args after '--' are intended for the p4 compiler
     argv = argv[1:]
@@ -28,6 +28,24 @@ limitations under the License.
 
 static int debug = 0;
 
+#ifdef UBPF_BURST_SIZE
+/* The program was compiled with --burst, feed the packets to process_burst() */
+extern uint64_t process_burst(struct ubpf_burst *burst);
+
+static uint64_t run_burst(uint32_t count, void **dp, struct standard_metadata **std_meta,
+                          uint64_t *results) {
+    struct ubpf_burst burst = { .count = count };
+    for (uint32_t i = 0; i < count; i++) {
+        burst.pkts[i] = dp[i];
+        burst.std_meta[i] = std_meta[i];
+    }
+    uint64_t forwarded = process_burst(&burst);
+    for (uint32_t i = 0; i < count; i++)
+        results[i] = burst.results[i];
+    return forwarded;
+}
+#endif
+
 void usage(char *name) {
     fprintf(stderr, "This program expects a pcap file pattern, "
             "extracts all the packets out of the matched files"
@@ -79,7 +97,11 @@ void launch_runtime(const char *pcap_name, uint16_t num_pcaps) {
     /* Sort the list */
     sort_pcap_list(input_list);
     /* Run the "program" and retrieve output lists */
+#ifdef UBPF_BURST_SIZE
+    RUN_BURST(run_burst, UBPF_BURST_SIZE, pcap_base, num_pcaps, input_list, debug);
+#else
     RUN(entry, pcap_base, num_pcaps, input_list, debug);
+#endif
     /* Delete the list of input packets */
     delete_list(input_list);
 }
@@ -20,39 +20,60 @@ limitations under the License.
 
 #define PCAPOUT "_out.pcap"
 
-pcap_list_t *feed_packets(packet_filter ebpf_filter, pcap_list_t *pkt_list, int debug) {
+struct std_meta {
+    uint32_t input_port;
+    uint32_t packet_length;
+    uint32_t output_action;
+    uint32_t output_port;
+};
+
+pcap_list_t *feed_packets(packet_filter ebpf_filter, burst_filter burst, uint32_t burst_size,
+                          pcap_list_t *pkt_list, int debug) {
     pcap_list_t *output_pkts = allocate_pkt_list();
     uint32_t list_len = get_pkt_list_length(pkt_list);
-    for (uint32_t i = 0; i < list_len; i++) {
-        /* Parse each packet in the list and check the result */
-        struct dp_packet dp;
-        struct std_meta {
-            uint32_t input_port;
-            uint32_t packet_length;
-            uint32_t output_action;
-            uint32_t output_port;
-        };
-        struct std_meta md;
-        pcap_pkt *input_pkt = get_packet(pkt_list, i);
-        dp.data = (void *) input_pkt->data;
-        dp.size_ = input_pkt->pcap_hdr.len;
+    if (burst == NULL || burst_size == 0)
+        burst_size = 1;
+    /* Packets are fed to the burst function burst_size at a time */
+    struct dp_packet dp[burst_size];
+    struct std_meta md[burst_size];
+    void *pkts[burst_size];
+    struct standard_metadata *std_meta[burst_size];
+    uint64_t results[burst_size];
+    for (uint32_t i = 0; i < list_len; i += burst_size) {
+        uint32_t count = list_len - i < burst_size ? list_len - i : burst_size;
+        for (uint32_t j = 0; j < count; j++) {
+            pcap_pkt *input_pkt = get_packet(pkt_list, i + j);
+            dp[j].data = (void *) input_pkt->data;
+            dp[j].size_ = input_pkt->pcap_hdr.len;
+
+            md[j].input_port = input_pkt->ifindex;
+            md[j].packet_length = dp[j].size_;
+            md[j].output_port = 0;
+            pkts[j] = &dp[j];
+            std_meta[j] = (struct standard_metadata *) &md[j];
+        }
 
-        md.input_port = input_pkt->ifindex;
-        md.packet_length = dp.size_;
-        md.output_port = 0;
+        if (burst != NULL)
+            burst(count, pkts, std_meta, results);
+        else
+            results[0] = ebpf_filter(pkts[0], std_meta[0]);
 
-        int result = ebpf_filter(&dp, (struct standard_metadata *) &md);
-        /* Updating input_pkt's length */
-        input_pkt->pcap_hdr.len = dp.size_;
-        input_pkt->pcap_hdr.caplen = dp.size_;
-        if (result != 0) {
-            /* We copy the entire content to emulate an outgoing packet */
-            pcap_pkt *out_pkt = copy_pkt(input_pkt);
-            out_pkt->ifindex = md.output_port;
-            output_pkts = append_packet(output_pkts, out_pkt);
+        for (uint32_t j = 0; j < count; j++) {
+            /* Parse each packet in the list and check the result */
+            pcap_pkt *input_pkt = get_packet(pkt_list, i + j);
+            int result = results[j];
+            /* Updating input_pkt's length */
+            input_pkt->pcap_hdr.len = dp[j].size_;
+            input_pkt->pcap_hdr.caplen = dp[j].size_;
+            if (result != 0) {
+                /* We copy the entire content to emulate an outgoing packet */
+                pcap_pkt *out_pkt = copy_pkt(input_pkt);
+                out_pkt->ifindex = md[j].output_port;
+                output_pkts = append_packet(output_pkts, out_pkt);
+            }
+            if (debug)
+                printf("Result of the eBPF parsing is: %d\n", result);
         }
-        if (debug)
-            printf("Result of the eBPF parsing is: %d\n", result);
     }
     return output_pkts;
 }
@@ -69,11 +90,12 @@ void write_pkts_to_pcaps(const char *pcap_base, pcap_list_array_t *output_array,
     }
 }
 
-void *run_and_record_output(packet_filter entry, const char *pcap_base, pcap_list_t *pkt_list, int debug) {
+void *run_and_record_output(packet_filter entry, burst_filter burst, uint32_t burst_size,
+                            const char *pcap_base, pcap_list_t *pkt_list, int debug) {
     /* Create an array of packet lists */
     pcap_list_array_t *output_array = allocate_pkt_list_array();
     /* Feed the packets into our "loaded" program */
-    pcap_list_t *output_pkts = feed_packets(entry, pkt_list, debug);
+    pcap_list_t *output_pkts = feed_packets(entry, burst, burst_size, pkt_list, debug);
     /* Split the output packet list by interface. This destroys the list. */
     output_array = split_and_delete_list(output_pkts, output_array);
     /* Write each list to a separate pcap output file */
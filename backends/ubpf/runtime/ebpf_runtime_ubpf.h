@@ -26,8 +26,12 @@ struct standard_metadata;
 
 extern uint64_t entry(void *, struct standard_metadata *);
 typedef uint64_t (*packet_filter)(void *dp, struct standard_metadata *std_meta);
+/* Processes count packets at once and stores the verdict of each one in results */
+typedef uint64_t (*burst_filter)(uint32_t count, void **dp, struct standard_metadata **std_meta,
+                                 uint64_t *results);
 
-void *run_and_record_output(packet_filter entry, const char *pcap_base, pcap_list_t *pkt_list, int debug);
+void *run_and_record_output(packet_filter entry, burst_filter burst, uint32_t burst_size,
+                            const char *pcap_base, pcap_list_t *pkt_list, int debug);
 
 static void inline init_ubpf_table_test(char *name, unsigned int key_size, unsigned int value_size) {
     struct bpf_table tbl = {
@@ -57,7 +61,9 @@ static void inline init_ubpf_table_test(char *name, unsigned int key_size, unsig
 #define INIT_UBPF_TABLE(name, key_size, value_size) init_ubpf_table_test("&"name, key_size, value_size)
 
 #define RUN(entry, pcap_base, num_pcaps, input_list, debug) \
-    run_and_record_output(entry, pcap_base, input_list, debug)
+    run_and_record_output(entry, NULL, 0, pcap_base, input_list, debug)
+#define RUN_BURST(burst, burst_size, pcap_base, num_pcaps, input_list, debug) \
+    run_and_record_output(NULL, burst, burst_size, pcap_base, input_list, debug)
 #define INIT_EBPF_TABLES(debug)
 #define DELETE_EBPF_TABLES(debug)
 
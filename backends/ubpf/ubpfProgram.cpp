@@ -79,8 +79,15 @@ namespace UBPF {
         builder->emitIndent();
         builder->target->emitChecksumHelpers(builder);
 
+        // With --burst the packet processing is inlined into both entry points.
+        cstring functionName = "entry";
+        if (options.burstSize > 0) {
+            functionName = "process_packet";
+            builder->appendLine("static inline __attribute__((always_inline))");
+        }
         builder->emitIndent();
-        builder->target->emitMain(builder, "entry", contextVar.c_str(), stdMetadataVar.c_str());
+        builder->target->emitMain(builder, functionName, contextVar.c_str(),
+                                  stdMetadataVar.c_str());
         builder->blockStart();
 
         emitPktVariable(builder);
@@ -127,6 +134,102 @@ namespace UBPF {
         builder->appendFormat("return %s;\n", builder->target->dropReturnCode().c_str());
         builder->decreaseIndent();
         builder->blockEnd(true);
+
+        if (options.burstSize > 0)
+            emitBurstEntry(builder);
+    }
+
+    void UBPFProgram::emitBurstType(EBPF::CodeBuilder *builder) const {
+        builder->appendFormat("#define UBPF_BURST_SIZE %u", options.burstSize);
+        builder->newline();
+        builder->newline();
+        builder->append("struct ubpf_burst ");
+        builder->blockStart();
+        builder->emitIndent();
+        builder->appendLine("uint32_t count;");
+        builder->emitIndent();
+        builder->appendLine("void *pkts[UBPF_BURST_SIZE];");
+        builder->emitIndent();
+        builder->appendLine("struct standard_metadata *std_meta[UBPF_BURST_SIZE];");
+        builder->emitIndent();
+        builder->appendLine("uint64_t results[UBPF_BURST_SIZE];");
+        builder->blockEnd(false);
+        builder->endOfStatement(true);
+        builder->newline();
+    }
+
+    /*
+     * The burst entry point takes a single argument, so that the uBPF VM can
+     * run it the same way as entry(). Each packet is processed by the inlined
+     * per-packet code while the data of the next packet is prefetched.
+     * Returns the number of packets to forward; the verdict of each packet
+     * is stored in burst->results.
+     * The VM runs the program from the start of the .text section, that is
+     * entry(), so process_burst() is placed in a section of its own, which
+     * the host loads instead of .text to run bursts.
+     */
+    void UBPFProgram::emitBurstEntry(UbpfCodeBuilder *builder) const {
+        builder->emitIndent();
+        builder->target->emitMain(builder, "entry", contextVar.c_str(), stdMetadataVar.c_str());
+        builder->blockStart();
+        builder->emitIndent();
+        builder->appendFormat("return process_packet(%s, %s);",
+                              contextVar.c_str(), stdMetadataVar.c_str());
+        builder->newline();
+        builder->blockEnd(true);
+        builder->newline();
+
+        builder->appendLine("#ifndef UBPF_PREFETCH");
+        builder->appendLine("#define UBPF_PREFETCH(addr) __builtin_prefetch(addr)");
+        builder->appendLine("#endif");
+        builder->newline();
+
+        builder->appendFormat("__attribute__((section(\"%s\")))", burstSection.c_str());
+        builder->newline();
+        builder->emitIndent();
+        builder->appendFormat("uint64_t process_burst(struct ubpf_burst *%s) ", burstVar.c_str());
+        builder->blockStart();
+        builder->emitIndent();
+        builder->appendFormat("uint32_t count = %s->count;", burstVar.c_str());
+        builder->newline();
+        builder->emitIndent();
+        builder->appendLine("uint64_t forwarded = 0;");
+        builder->emitIndent();
+        builder->appendLine("if (count > UBPF_BURST_SIZE)");
+        builder->increaseIndent();
+        builder->emitIndent();
+        builder->appendLine("count = UBPF_BURST_SIZE;");
+        builder->decreaseIndent();
+        builder->emitIndent();
+        builder->append("for (uint32_t i = 0; i < count; i++) ");
+        builder->blockStart();
+        builder->emitIndent();
+        builder->appendLine("if (i + 1 < count)");
+        builder->increaseIndent();
+        builder->emitIndent();
+        builder->appendFormat("UBPF_PREFETCH(ubpf_packet_data(%s->pkts[i + 1]));",
+                              burstVar.c_str());
+        builder->newline();
+        builder->decreaseIndent();
+        builder->emitIndent();
+        builder->appendFormat("uint64_t result = process_packet(%s->pkts[i], %s->std_meta[i]);",
+                              burstVar.c_str(), burstVar.c_str());
+        builder->newline();
+        builder->emitIndent();
+        builder->appendFormat("%s->results[i] = result;", burstVar.c_str());
+        builder->newline();
+        builder->emitIndent();
+        builder->appendFormat("if (result == %s)",
+                              builder->target->forwardReturnCode().c_str());
+        builder->newline();
+        builder->increaseIndent();
+        builder->emitIndent();
+        builder->appendLine("forwarded++;");
+        builder->decreaseIndent();
+        builder->blockEnd(true);
+        builder->emitIndent();
+        builder->appendLine("return forwarded;");
+        builder->blockEnd(true);
     }
 
     void UBPFProgram::emitH(EBPF::CodeBuilder *builder, cstring) {
@@ -140,6 +243,8 @@ namespace UBPF {
         emitTableDefinition(builder);
         builder->newline();
         control->emitTableTypes(builder);
+        if (options.burstSize > 0)
+            emitBurstType(builder);
         builder->appendLine("#if CONTROL_PLANE");
         builder->appendLine("static void init_tables() ");
         builder->blockStart();
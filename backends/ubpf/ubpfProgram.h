@@ -44,6 +44,7 @@ class UBPFProgram : public EBPF::EBPFProgram {
     cstring contextVar, outerHdrOffsetVar, outerHdrLengthVar;
     cstring stdMetadataVar;
     cstring packetTruncatedSizeVar;
+    cstring burstVar, burstSection;
     cstring arrayIndexType = "uint32_t";
 
     UBPFProgram(const EbpfOptions &options, const IR::P4Program *program,
@@ -59,6 +60,8 @@ class UBPFProgram : public EBPF::EBPFProgram {
         endLabel = cstring("deparser");
         stdMetadataVar = cstring("std_meta");
         packetTruncatedSizeVar = cstring("packetTruncatedSize");
+        burstVar = cstring("burst");
+        burstSection = cstring("ubpf_burst");
     }
 
     bool build() override;
@@ -73,6 +76,8 @@ class UBPFProgram : public EBPF::EBPFProgram {
     void emitMetadataInstance(EBPF::CodeBuilder *builder) const;
     void emitLocalVariables(EBPF::CodeBuilder *builder) override;
     void emitPipeline(EBPF::CodeBuilder *builder) override;
+    void emitBurstType(EBPF::CodeBuilder *builder) const;
+    void emitBurstEntry(UbpfCodeBuilder *builder) const;
 };
 
 }  // namespace UBPF
@@ -71,6 +71,14 @@ CompilerOptions::CompilerOptions() : ParserOptions() {
             return true;
         },
         "[Compiler debugging] Dump and undump the IR");
+    registerOption(
+        "--frontend-cache", "dir",
+        [this](const char* arg) {
+            frontendCacheDir = arg;
+            return true;
+        },
+        "Cache the result of the front-end in the specified (existing) directory\n"
+        "and reuse it when the same program is compiled again with the same options.");
     registerOption(
         "--pp", "file",
         [this](const char* arg) {
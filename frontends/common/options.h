@@ -77,6 +77,8 @@ class CompilerOptions : public ParserOptions {
     cstring arch = nullptr;
     // If true, unroll all parser loops inside the midend.
     bool loopsUnrolling = false;
+    // Directory in which the result of the front-end is cached.
+    cstring frontendCacheDir = nullptr;
 
     virtual bool enable_intrinsic_metadata_fix();
 };
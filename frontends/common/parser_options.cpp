@@ -23,6 +23,7 @@ limitations under the License.
 #include <unordered_set>
 
 #include "frontends/p4/toP4/toP4.h"
+#include "ir/census.h"
 #include "ir/json_generator.h"
 #include "lib/exceptions.h"
 #include "lib/exename.h"
@@ -267,6 +268,18 @@ ParserOptions::ParserOptions() : Util::Options(defaultMessage) {
         "[Compiler debugging] Dump the P4 representation after\n"
         "passes whose name contains one of `passX' substrings.\n"
         "When '-v' is used this will include the compiler IR.\n");
+    registerOption(
+        "--memoryCensus", "pass1[,pass2]",
+        [this](const char* arg) {
+            auto copy = strdup(arg);
+            while (auto pass = strsep(&copy, ","))
+                memoryCensus.push_back(pass);
+            return true;
+        },
+        "[Compiler debugging] Write the number and size of the IR nodes of each\n"
+        "type, the size of the string table and the live heap as JSON after\n"
+        "passes whose name contains one of `passX' substrings.  The type and\n"
+        "reference maps owned by the passes are not included.\n");
     registerOption(
         "--dump", "folder",
         [this](const char* arg) {
@@ -462,15 +475,9 @@ bool ParserOptions::isv1() const {
     return langVersion == ParserOptions::FrontendVersion::P4_14;
 }
 
-void ParserOptions::dumpPass(const char* manager, unsigned seq,
-                             const char* pass, const IR::Node* node) const {
-    if (strncmp(pass, "P4::", 4) == 0)
-        pass += 4;
-    cstring name = cstring(manager) + "_" + Util::toString(seq) + "_" + pass;
-    if (Log::verbose())
-        std::cerr << name << std::endl;
-
-    for (auto s : top4) {
+// True if the pass name contains a match of one of the regular expressions.
+static bool passMatches(cstring name, const std::vector<cstring> &regexes) {
+    for (auto s : regexes) {
         bool match = false;
         try {
             auto s_regex = std::regex(s, std::regex_constants::ECMAScript);
@@ -485,25 +492,52 @@ void ParserOptions::dumpPass(const char* manager, unsigned seq,
                     s);
             exit(1);
         }
-        if (match) {
-            cstring suffix = cstring("-") + name;
-            cstring filename = file;
-            if (filename == "-")
-                filename = "tmp.p4";
-
-            cstring fileName = makeFileName(dumpFolder, filename, suffix);
-            auto stream = openFile(fileName, true);
-            if (stream != nullptr) {
-                if (Log::verbose())
-                    std::cerr << "Writing program to " << fileName << std::endl;
-                P4::ToP4 toP4(stream, Log::verbose(), file);
-                if (noIncludes) {
-                    toP4.setnoIncludesArg(true);
-                }
-                node->apply(toP4);
-                delete stream;  // close the file
+        if (match)
+            return true;
+    }
+    return false;
+}
+
+void ParserOptions::dumpPass(const char* manager, unsigned seq,
+                             const char* pass, const IR::Node* node) const {
+    if (strncmp(pass, "P4::", 4) == 0)
+        pass += 4;
+    cstring name = cstring(manager) + "_" + Util::toString(seq) + "_" + pass;
+    if (Log::verbose())
+        std::cerr << name << std::endl;
+
+    cstring filename = file;
+    if (filename == "-")
+        filename = "tmp.p4";
+
+    if (passMatches(name, memoryCensus)) {
+        // folder/file-<pass>-census.json
+        cstring fileName = Util::PathName(dumpFolder).join(
+            Util::PathName(filename).getBasename() + "-" + name + "-census.json").toString();
+        auto stream = openFile(fileName, true);
+        if (stream != nullptr) {
+            if (Log::verbose())
+                std::cerr << "Writing memory census to " << fileName << std::endl;
+            NodeCensus census;
+            node->apply(census);
+            census.toJSON(*stream, name);
+            delete stream;  // close the file
+        }
+    }
+
+    if (passMatches(name, top4)) {
+        cstring suffix = cstring("-") + name;
+        cstring fileName = makeFileName(dumpFolder, filename, suffix);
+        auto stream = openFile(fileName, true);
+        if (stream != nullptr) {
+            if (Log::verbose())
+                std::cerr << "Writing program to " << fileName << std::endl;
+            P4::ToP4 toP4(stream, Log::verbose(), file);
+            if (noIncludes) {
+                toP4.setnoIncludesArg(true);
             }
-            break;
+            node->apply(toP4);
+            delete stream;  // close the file
         }
     }
 }
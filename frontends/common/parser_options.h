@@ -70,6 +70,9 @@ class ParserOptions : public Util::Options {
     bool doNotPreprocess = false;
     // substrings matched against pass names
     std::vector<cstring> top4;
+    // regular expressions matched against pass names; a memory census of the
+    // IR is written after the passes that match
+    std::vector<cstring> memoryCensus;
     // debugging dumps of programs written in this folder
     cstring dumpFolder = ".";
     // If false, optimization of callee parsers (subparsers) inlining is disabled.
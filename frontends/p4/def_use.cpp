@@ -273,7 +273,23 @@ bool LocationSet::overlaps(const LocationSet* other) const {
     return false;
 }
 
+bool ProgramPoints::contains(const ProgramPoints* other) const {
+    if (other == this)
+        return true;
+    if (other->points.size() > points.size())
+        return false;
+    for (auto &p : other->points)
+        if (points.find(p) == points.end())
+            return false;
+    return true;
+}
+
 const ProgramPoints* ProgramPoints::merge(const ProgramPoints* with) const {
+    // Joins mostly merge identical or nested sets; avoid copying those.
+    if (contains(with))
+        return this;
+    if (with->contains(this))
+        return with;
     auto result = new ProgramPoints(points);
     for (auto p : with->points)
         result->points.emplace(p);
@@ -281,13 +297,20 @@ const ProgramPoints* ProgramPoints::merge(const ProgramPoints* with) const {
 }
 
 ProgramPoint::ProgramPoint(const ProgramPoint &context, const IR::Node* node) {
+    stack.reserve(context.stack.size() + 1);
     for (auto e : context.stack)
         stack.push_back(e);
     stack.push_back(node);
+    computeHash();
+}
+
+void ProgramPoint::computeHash() {
+    hashValue = 0;
+    boost::hash_range(hashValue, stack.begin(), stack.end());
 }
 
 bool ProgramPoint::operator==(const ProgramPoint& other) const {
-    if (stack.size() != other.stack.size())
+    if (hashValue != other.hashValue || stack.size() != other.stack.size())
         return false;
     for (unsigned i=0; i < stack.size(); i++)
         if (stack.at(i) != other.stack.at(i))
@@ -295,13 +318,9 @@ bool ProgramPoint::operator==(const ProgramPoint& other) const {
     return true;
 }
 
-std::size_t ProgramPoint::hash() const {
-    std::size_t result = 0;
-    boost::hash_range(result, stack.begin(), stack.end());
-    return result;
-}
-
 bool ProgramPoints::operator==(const ProgramPoints& other) const {
+    if (&other == this)
+        return true;
     if (points.size() != other.points.size())
         return false;
     for (auto p : points)
@@ -317,8 +336,7 @@ Definitions* Definitions::joinDefinitions(const Definitions* other) const {
         auto defs = d.second;
         auto current = ::get(definitions, loc);
         if (current != nullptr) {
-            auto merged = current->merge(defs);
-            result->definitions.emplace(loc, merged);
+            result->definitions.emplace(loc, current->merge(defs));
         } else {
             result->definitions.emplace(loc, defs);
         }
@@ -360,10 +378,11 @@ void Definitions::removeLocation(const StorageLocation* location) {
 }
 
 const ProgramPoints* Definitions::getPoints(const LocationSet* locations) const {
-    const ProgramPoints* result = new ProgramPoints();
+    auto result = new ProgramPoints();
     for (auto sl : *locations->canonicalize()) {
         auto points = getPoints(sl->to<BaseLocation>());
-        result = result->merge(points);
+        for (auto &p : *points)
+            result->add(p);
     }
     return result;
 }
@@ -385,7 +404,7 @@ bool Definitions::operator==(const Definitions& other) const {
         auto od = ::get(other.definitions, d.first);
         if (od == nullptr)
             return false;
-        if (!d.second->operator==(*od))
+        if (od != d.second && !d.second->operator==(*od))
             return false;
     }
     return true;
@@ -270,18 +270,23 @@ class ProgramPoint : public IHasDbPrint {
     /// the function, while [Function, nullptr] is the context after the
     /// function terminates.
     std::vector<const IR::Node*> stack;
+    /// Hash of the stack, computed once since program points are hashed and
+    /// compared repeatedly when merging definitions.
+    std::size_t hashValue = 0;
+    void computeHash();
 
  public:
     ProgramPoint() = default;
-    ProgramPoint(const ProgramPoint& other) : stack(other.stack) {}
-    explicit ProgramPoint(const IR::Node* node) { CHECK_NULL(node); stack.push_back(node); }
+    ProgramPoint(const ProgramPoint& other) : stack(other.stack), hashValue(other.hashValue) {}
+    explicit ProgramPoint(const IR::Node* node)
+    { CHECK_NULL(node); stack.push_back(node); computeHash(); }
     ProgramPoint(const ProgramPoint& context, const IR::Node* node);
     /// A point logically before the function/control/action start.
     static ProgramPoint beforeStart;
     /// We use a nullptr to indicate a point *after* the previous context
     ProgramPoint after() { return ProgramPoint(*this, nullptr); }
     bool operator==(const ProgramPoint& other) const;
-    std::size_t hash() const;
+    std::size_t hash() const { return hashValue; }
     void dbprint(std::ostream& out) const override {
         if (isBeforeStart()) {
             out << "<BeforeStart>";
@@ -334,7 +339,10 @@ class ProgramPoints : public IHasDbPrint {
     ProgramPoints() = default;
     explicit ProgramPoints(ProgramPoint point) { points.emplace(point); }
     void add(ProgramPoint point) { points.emplace(point); }
+    /// @returns the union of this and 'with'; reuses one of the operands
+    /// when it already contains the other.
     const ProgramPoints* merge(const ProgramPoints* with) const;
+    bool contains(const ProgramPoints* other) const;
     bool operator==(const ProgramPoints& other) const;
     void dbprint(std::ostream& out) const override {
         out << "{";
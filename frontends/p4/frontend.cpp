@@ -14,10 +14,16 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <unistd.h>
+#include <cstdio>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 #include "ir/ir.h"
+#include "ir/json_generator.h"
+#include "ir/json_loader.h"
+#include "lib/hash.h"
 #include "../common/options.h"
 #include "lib/nullstream.h"
 #include "lib/path.h"
@@ -141,6 +147,73 @@ class SetStrictStruct : public NoVisit {
     }
 };
 
+/**
+Returns the file caching the result of the front-end for this program, or
+nullptr if caching is disabled.  The name is derived from the program,
+including the source positions (which are also stored with the result),
+and from everything else which can change the output of the front-end.
+*/
+cstring frontEndCacheFile(const CompilerOptions& options, const IR::P4Program* program,
+                          bool skipSideEffectOrdering) {
+    if (options.frontendCacheDir.isNullOrEmpty())
+        return nullptr;
+    // The pretty-printer, the dumps and the censuses are side outputs of the passes.
+    if (!options.prettyPrintFile.isNullOrEmpty() || !options.top4.empty() ||
+        !options.memoryCensus.empty())
+        return nullptr;
+    std::stringstream key;
+    key << options.exe_name << "\n" << options.compilerVersion << "\n"
+        << static_cast<int>(options.langVersion) << options.isv1()
+        << options.optimizeParserInlining << skipSideEffectOrdering << "\n";
+    if (options.excludeFrontendPasses) {
+        for (auto pass : options.passesToExcludeFrontend)
+            key << pass << ",";
+    }
+    key << "\n";
+    JSONGenerator(key, true) << program;
+    auto text = key.str();
+    std::stringstream name;
+    name << std::hex << Util::Hash::fnv1a(text.data(), text.size())
+         << Util::Hash::murmur(text.data(), text.size()) << ".json";
+    Util::PathName path(options.frontendCacheDir);
+    return path.join(name.str()).toString();
+}
+
+const IR::P4Program* loadFrontEndCache(cstring file) {
+    std::ifstream json(file);
+    if (!json)
+        return nullptr;
+    JSONLoader loader(json);
+    const IR::Node* node = nullptr;
+    loader >> node;
+    if (node == nullptr || !node->is<IR::P4Program>()) {
+        LOG1("Ignoring invalid front-end cache file " << file);
+        return nullptr;
+    }
+    LOG1("Reusing front-end result from " << file);
+    return node->to<IR::P4Program>();
+}
+
+/// Writes to a temporary file first, so that concurrent compilations
+/// never read a partial result.  The temporary file is unique to this
+/// process, so that concurrent writers of the same result do not clobber
+/// each other's file before renaming it.
+void storeFrontEndCache(cstring file, const IR::P4Program* program) {
+    cstring tmp = file + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream json(tmp);
+        if (!json) {
+            LOG1("Cannot write front-end cache file " << tmp);
+            return;
+        }
+        JSONGenerator(json, true) << program << std::endl;
+        if (!json)
+            return;
+    }
+    if (std::rename(tmp, file) != 0)
+        std::remove(tmp);
+}
+
 }  // namespace
 
 // TODO: remove skipSideEffectOrdering flag
@@ -195,12 +268,12 @@ const IR::P4Program *FrontEnd::run(const CompilerOptions &options, const IR::P4P
         new RemoveParserIfs(&refMap, &typeMap),
         new StructInitializers(&refMap, &typeMap),
         new TableKeyNames(&refMap, &typeMap),
-        new PassRepeated({
+        (new PassRepeated({
             new ConstantFolding(&refMap, &typeMap),
             new StrengthReduction(&refMap, &typeMap),
             new Reassociation(),
             new UselessCasts(&refMap, &typeMap)
-        }),
+        }))->setSkipConverged(),
         new SimplifyControlFlow(&refMap, &typeMap),
         new SwitchAddDefault,
         new FrontEndDump(),  // used for testing the program at this point
@@ -260,7 +333,18 @@ const IR::P4Program *FrontEnd::run(const CompilerOptions &options, const IR::P4P
     passes.setName("FrontEnd");
     passes.setStopOnError(true);
     passes.addDebugHooks(hooks, true);
+
+    // Programs producing warnings are not cached, so that the warnings
+    // are reported by every compilation.
+    cstring cacheFile = frontEndCacheFile(options, program, skipSideEffectOrdering);
+    if (cacheFile) {
+        if (auto cached = loadFrontEndCache(cacheFile))
+            return cached;
+    }
+    auto diagnostics = ::diagnosticCount();
     const IR::P4Program* result = program->apply(passes);
+    if (cacheFile && result != nullptr && ::diagnosticCount() == diagnostics)
+        storeFrontEndCache(cacheFile, result);
     return result;
 }
 
@@ -350,16 +350,17 @@ void InlineList::analyze() {
         cg.calls(inl->caller, inl->callee);
     }
 
+    std::map<const IR::IContainer*, std::vector<CallInfo*>> byCaller;
+    for (auto m : inlineMap)
+        byCaller[m.second->caller].push_back(m.second);
+
     // must inline from leaves up
     std::vector<const IR::IContainer*> order;
     cg.sort(order);
     for (auto c : order) {
-        // This is quadratic, but hopefully the call graph is not too large
-        for (auto m : inlineMap) {
-            auto inl = m.second;
-            if (inl->caller == c)
-                toInline.push_back(inl);
-        }
+        auto it = byCaller.find(c);
+        if (it != byCaller.end())
+            toInline.insert(toInline.end(), it->second.begin(), it->second.end());
     }
 
     std::reverse(toInline.begin(), toInline.end());
@@ -590,13 +591,14 @@ void GeneralInliner::inline_subst(P4Block *caller,
                 }
             }
 
-            /* We will perform these substitutions twice: once here, to
-               compute the names for the locals that we need to inline here,
-               and once again at the call site (where we do additional
-               substitutions, including the callee parameters). */
+            /* Rename the callee once here, to compute the names for the
+               locals that we need to inline here.  The renamed callee is
+               remembered and reused by renameCallee at the first call site;
+               further call sites of the same instance rename it again. */
             auto clone = substs->rename<P4Block>(refMap, callee);
             for (auto i : clone->*blockLocals)
                 locals.push_back(i);
+            workToDo->renamedCallee[inst] = clone;
         }
     }
     caller->*blockLocals = locals;
@@ -604,6 +606,23 @@ void GeneralInliner::inline_subst(P4Block *caller,
     caller->*blockType = type;
 }
 
+/* The substitutions of an instance are the same for all its invocations,
+ * so the callee renamed by inline_subst can be used for one of them; the
+ * other invocations need fresh copies, since IR nodes cannot be shared
+ * between the inlined bodies. */
+template<class P4Block>
+const P4Block* GeneralInliner::renameCallee(const IR::Declaration_Instance* decl,
+                                            const P4Block* callee,
+                                            PerInstanceSubstitutions* substs) {
+    auto it = workToDo->renamedCallee.find(decl);
+    if (it == workToDo->renamedCallee.end())
+        return substs->rename<P4Block>(refMap, callee);
+    auto result = it->second->to<P4Block>();
+    CHECK_NULL(result);
+    workToDo->renamedCallee.erase(it);
+    return result;
+}
+
 const IR::Node* GeneralInliner::preorder(IR::P4Control* caller) {
     // prepares the code to inline
     auto orig = getOriginal<IR::P4Control>();
@@ -670,7 +689,7 @@ const IR::Node* GeneralInliner::preorder(IR::MethodCallStatement* statement) {
     }
 
     // inline actual body
-    callee = substs->rename<IR::P4Control>(refMap, callee);
+    callee = renameCallee(decl, callee, substs);
     body.append(callee->body->components);
 
     // Copy values of out and inout parameters
@@ -853,7 +872,7 @@ const IR::Node* GeneralInliner::preorder(IR::ParserState* state) {
             }
         }
 
-        callee = substs->rename<IR::P4Parser>(refMap, callee);
+        callee = renameCallee(decl, callee, substs);
 
         cstring nextState = refMap->newName(state->name);
         std::map<cstring, cstring> renameMap;
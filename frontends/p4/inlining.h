@@ -164,6 +164,10 @@ struct InlineSummary : public IHasDbPrint {
         std::map<const IR::Declaration_Instance*, PerInstanceSubstitutions*> substitutions;
         /// For each invocation (key) call the instance that is invoked.
         std::map<const IR::MethodCallStatement*, const IR::Declaration_Instance*> callToInstance;
+        /// For each instance (key) the callee after applying the substitutions,
+        /// computed to obtain the locals to inline.  The first invocation of the
+        /// instance takes its body from here instead of renaming the callee again.
+        std::map<const IR::Declaration_Instance*, const IR::IContainer*> renamedCallee;
 
         /**
          * For each distinct invocation of the subparser identified by InlinedInvocationInfo
@@ -392,6 +396,10 @@ class GeneralInliner : public AbstractInliner<InlineList, InlineSummary> {
     InlineSummary::PerCaller* workToDo;
     bool optimizeParserInlining;
 
+    template<class P4Block>
+    const P4Block* renameCallee(const IR::Declaration_Instance* decl, const P4Block* callee,
+                                PerInstanceSubstitutions* substs);
+
  public:
     explicit GeneralInliner(bool isv1, bool _optimizeParserInlining) :
             refMap(new ReferenceMap()), typeMap(new TypeMap()), workToDo(nullptr),
@@ -66,7 +66,7 @@ const IR::Node* DoSimplifyExpressions::preorder(IR::Literal* expression) {
 const IR::Node* DoSimplifyExpressions::preorder(IR::ArrayIndex* expression) {
     LOG3("Visiting " << dbp(expression));
     auto type = typeMap->getType(getOriginal(), true);
-    if (SideEffects::check(getOriginal<IR::Expression>(), this, refMap, typeMap) ||
+    if (hasSideEffects(getOriginal<IR::Expression>()) ||
         // if the expression appears as part of an argument also use a temporary for the index
         findContext<IR::Argument>() != nullptr) {
         visit(expression->left);
@@ -102,7 +102,7 @@ const IR::Node* DoSimplifyExpressions::preorder(IR::Member* expression) {
     LOG3("Visiting " << dbp(expression));
     auto type = typeMap->getType(getOriginal(), true);
     const IR::Expression *rv = expression;
-    if (SideEffects::check(getOriginal<IR::Expression>(), this, refMap, typeMap) ||
+    if (hasSideEffects(getOriginal<IR::Expression>()) ||
         // This may be part of a left-value that is passed as an out argument
         findContext<IR::Argument>() != nullptr) {
         visit(expression->expr);
@@ -156,7 +156,7 @@ const IR::Node* DoSimplifyExpressions::preorder(IR::StructExpression* expression
     LOG3("Visiting " << dbp(expression));
     bool foundEffect = false;
     for (auto v : expression->components) {
-        if (SideEffects::check(v->expression, this, refMap, typeMap)) {
+        if (hasSideEffects(v->expression)) {
             foundEffect = true;
             break;
         }
@@ -185,7 +185,7 @@ const IR::Node* DoSimplifyExpressions::preorder(IR::ListExpression* expression)
     LOG3("Visiting " << dbp(expression));
     bool foundEffect = false;
     for (auto v : expression->components) {
-        if (SideEffects::check(v, this, refMap, typeMap)) {
+        if (hasSideEffects(v)) {
             foundEffect = true;
             break;
         }
@@ -211,8 +211,8 @@ const IR::Node* DoSimplifyExpressions::preorder(IR::Operation_Binary* expression
     LOG3("Visiting " << dbp(expression));
     auto original = getOriginal<IR::Operation_Binary>();
     auto type = typeMap->getType(original, true);
-    if (SideEffects::check(original, this, refMap, typeMap)) {
-        if (SideEffects::check(original->right, this, refMap, typeMap)) {
+    if (hasSideEffects(original)) {
+        if (hasSideEffects(original->right)) {
             // We are a bit conservative here. We handle this case:
             // T f(inout T val) { ... }
             // val + f(val);
@@ -243,7 +243,7 @@ const IR::Node* DoSimplifyExpressions::preorder(IR::Operation_Binary* expression
 const IR::Node* DoSimplifyExpressions::shortCircuit(IR::Operation_Binary* expression) {
     LOG3("Visiting " << dbp(expression));
     auto type = typeMap->getType(getOriginal(), true);
-    if (SideEffects::check(getOriginal<IR::Expression>(), this, refMap, typeMap)) {
+    if (hasSideEffects(getOriginal<IR::Expression>())) {
         visit(expression->left);
         CHECK_NULL(expression->left);
 
@@ -391,7 +391,7 @@ const IR::Node* DoSimplifyExpressions::preorder(IR::MethodCallExpression* mce) {
     LOG3("Visiting " << dbp(mce));
     auto orig = getOriginal<IR::MethodCallExpression>();
     auto type = typeMap->getType(orig, true);
-    if (!SideEffects::check(orig, this, refMap, typeMap)) {
+    if (!hasSideEffects(orig)) {
         return mce;
     }
 
@@ -427,7 +427,7 @@ const IR::Node* DoSimplifyExpressions::preorder(IR::MethodCallExpression* mce) {
 
         // If an argument evaluation has side-effects then
         // always use a temporary to hold the argument value.
-        if (SideEffects::check(arg->expression, this, refMap, typeMap)) {
+        if (hasSideEffects(arg->expression)) {
             LOG3("Using temporary for " << dbp(mce) <<
                  " param " << dbp(p) << " arg side effect");
             useTemporary.emplace(p);
@@ -694,6 +694,11 @@ const IR::Node* DoSimplifyExpressions::preorder(IR::SwitchStatement* statement)
     return rv;
 }
 
+Visitor::profile_t DoSimplifyExpressions::init_apply(const IR::Node* node) {
+    callEffects.clear();
+    return Transform::init_apply(node);
+}
+
 void DoSimplifyExpressions::end_apply(const IR::Node *) {
     BUG_CHECK(toInsert.empty(), "DoSimplifyExpressions::end_apply orphaned declarations");
     BUG_CHECK(statements.empty(), "DoSimplifyExpressions::end_apply orphaned statements");
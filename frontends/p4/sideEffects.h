@@ -19,6 +19,8 @@ limitations under the License.
 
 /* makes explicit side effect ordering */
 
+#include <unordered_map>
+
 #include "ir/ir.h"
 #include "frontends/common/resolveReferences/referenceMap.h"
 #include "frontends/p4/typeChecking/typeChecker.h"
@@ -58,9 +60,23 @@ class HasTableApply : public Inspector {
  * of ```isValid()``` are ignored.
  */
 class SideEffects : public Inspector {
+ public:
+    /// Remembers, for each method call, whether it has side effects, so that
+    /// the call is resolved only once when the enclosing expressions are
+    /// checked repeatedly.  Only valid while the refMap and typeMap used to
+    /// fill it are unchanged, i.e., within a single pass.
+    typedef std::unordered_map<const IR::MethodCallExpression*, bool> CallCache;
+
  private:
     ReferenceMap* refMap;
     TypeMap*      typeMap;
+    CallCache*    callCache;
+
+    bool callHasSideEffect(const IR::MethodCallExpression* mce) const {
+        auto mi = MethodInstance::resolve(mce, refMap, typeMap);
+        auto bim = mi->to<BuiltInMethod>();
+        return bim == nullptr || bim->name.name != IR::Type_Header::isValid;
+    }
 
  public:
     /// Last visited side-effecting node.  Null if no node has side effects.
@@ -70,20 +86,18 @@ class SideEffects : public Inspector {
     unsigned sideEffectCount = 0;
 
     void postorder(const IR::MethodCallExpression* mce) override {
-        if (refMap == nullptr || typeMap == nullptr) {
-            // conservative
-            sideEffectCount++;
-            nodeWithSideEffect = mce;
-            return;
-        }
-        auto mi = MethodInstance::resolve(mce, refMap, typeMap);
-        if (!mi->is<BuiltInMethod>()) {
-            sideEffectCount++;
-            nodeWithSideEffect = mce;
-            return;
+        bool effect = true;  // conservative when refMap or typeMap are missing
+        if (refMap != nullptr && typeMap != nullptr) {
+            if (callCache == nullptr) {
+                effect = callHasSideEffect(mce);
+            } else {
+                auto it = callCache->find(mce);
+                if (it == callCache->end())
+                    it = callCache->emplace(mce, callHasSideEffect(mce)).first;
+                effect = it->second;
+            }
         }
-        auto bim = mi->to<BuiltInMethod>();
-        if (bim->name.name != IR::Type_Header::isValid) {
+        if (effect) {
             sideEffectCount++;
             nodeWithSideEffect = mce;
         }
@@ -96,13 +110,14 @@ class SideEffects : public Inspector {
 
     /// The @refMap and @typeMap arguments can be null, in which case the check
     /// will be more conservative.
-    SideEffects(ReferenceMap* refMap, TypeMap* typeMap) :
-            refMap(refMap), typeMap(typeMap) { setName("SideEffects"); }
+    SideEffects(ReferenceMap* refMap, TypeMap* typeMap, CallCache* callCache = nullptr) :
+            refMap(refMap), typeMap(typeMap), callCache(callCache) { setName("SideEffects"); }
 
     /// @return true if the expression may have side-effects.
     static bool check(const IR::Expression* expression, const Visitor* calledBy,
-                      ReferenceMap* refMap, TypeMap* typeMap) {
-        SideEffects se(refMap, typeMap);
+                      ReferenceMap* refMap, TypeMap* typeMap,
+                      CallCache* callCache = nullptr) {
+        SideEffects se(refMap, typeMap, callCache);
         se.setCalledBy(calledBy);
         expression->apply(se);
         return se.nodeWithSideEffect != nullptr;
@@ -185,6 +200,12 @@ class DoSimplifyExpressions : public Transform, P4WriteContext {
     /// Set of temporaries introduced for method call results during
     /// this pass.
     std::set<const IR::Expression*> temporaries;
+    /// Side effects of the method calls seen so far; the same subexpressions
+    /// are checked again for every enclosing expression.
+    SideEffects::CallCache callEffects;
+    bool hasSideEffects(const IR::Expression* expression) {
+        return SideEffects::check(expression, this, refMap, typeMap, &callEffects);
+    }
 
     cstring createTemporary(const IR::Type* type);
     const IR::Expression* addAssignment(Util::SourceInfo srcInfo, cstring varName,
@@ -230,6 +251,7 @@ class DoSimplifyExpressions : public Transform, P4WriteContext {
     const IR::Node* preorder(IR::SwitchStatement* statement) override;
     const IR::Node* preorder(IR::IfStatement* statement) override;
 
+    profile_t init_apply(const IR::Node* node) override;
     void end_apply(const IR::Node *) override;
 };
 
@@ -60,9 +60,16 @@ cstring TypeVariableSubstitution::compose(const IR::ITypeVar* var, const IR::Typ
     if (!success)
         BUG("Cannot set binding");
 
+    // Most bound types do not mention var; finding out is much cheaper
+    // than running the substitution, which copies every node it visits.
     TypeVariableSubstitutionVisitor visitor(tvs);
+    TypeOccursVisitor mentions(var);
     for (auto &bound : binding) {
         const IR::Type* type = bound.second;
+        mentions.occurs = false;
+        type->apply(mentions);
+        if (!mentions.occurs)
+            continue;
         const IR::Node* newType = type->apply(visitor);
         if (newType == nullptr)
             return "Could not replace '%1%' with '%2%'";
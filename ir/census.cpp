@@ -0,0 +1,60 @@
+/*
+Copyright 2026 The P4 Language Consortium
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "census.h"
+#include "lib/gc.h"
+#include "lib/json.h"
+
+bool NodeCensus::preorder(const IR::Node* node) {
+    // Nodes have virtual bases, so the node may not start the allocation.
+    size_t bytes = gc_object_size(dynamic_cast<const void*>(node));
+    auto &entry = byType[node->node_type_name()];
+    entry.count++;
+    entry.bytes += bytes;
+    total.count++;
+    total.bytes += bytes;
+    return true;
+}
+
+void NodeCensus::toJSON(std::ostream &out, cstring pass) const {
+    auto json = new Util::JsonObject();
+    json->emplace("pass", pass);
+    json->emplace("nodes", total.count);
+    json->emplace("node_bytes", total.bytes);
+
+    auto types = new Util::JsonArray();
+    for (auto &t : byType) {
+        auto type = new Util::JsonObject();
+        type->emplace("type", t.first);
+        type->emplace("count", t.second.count);
+        type->emplace("bytes", t.second.bytes);
+        types->append(type);
+    }
+    json->emplace("node_types", types);
+
+    size_t strings;
+    size_t stringBytes = cstring::cache_size(strings);
+    json->emplace("cstrings", strings);
+    json->emplace("cstring_bytes", stringBytes);
+
+    size_t heapSize;
+    size_t inUse = gc_mem_inuse(&heapSize);
+    json->emplace("heap_in_use", inUse);
+    json->emplace("heap_size", heapSize);
+
+    json->serialize(out);
+    out << std::endl;
+}
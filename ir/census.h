@@ -0,0 +1,47 @@
+/*
+Copyright 2026 The P4 Language Consortium
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _IR_CENSUS_H_
+#define _IR_CENSUS_H_
+
+#include <iostream>
+#include <map>
+
+#include "ir/ir.h"
+
+/// Counts the distinct IR nodes reachable from a node and the heap memory
+/// they occupy, per node class.  The byte counts are only available when
+/// the compiler is built with the garbage collector.
+class NodeCensus : public Inspector {
+ public:
+    struct Entry {
+        size_t count = 0;
+        size_t bytes = 0;
+    };
+
+    std::map<cstring, Entry> byType;
+    Entry total;
+
+    NodeCensus() { setName("NodeCensus"); }
+    bool preorder(const IR::Node* node) override;
+
+    /// Writes the census as JSON, together with the size of the string
+    /// table and of the live heap (which requires a full collection).
+    /// @pass is the name of the pass after which the census was taken.
+    void toJSON(std::ostream &out, cstring pass) const;
+};
+
+#endif /* _IR_CENSUS_H_ */
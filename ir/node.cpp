@@ -106,18 +106,19 @@ Util::JsonObject* IR::Node::sourceInfoJsonObj() const {
     unsigned lineNumber, columnNumber;
     cstring fName = prepareSourceInfoForJSON(si, &lineNumber, &columnNumber);
     if (fName == nullptr) {
-        if (si.line == -1) {
-            // -1 is default value for objects when SourceInfo
-            // was not read from jsonFile using "--fromJSON" flag
+        auto saved = srcInfo.getSavedPosition();
+        if (saved == nullptr) {
+            // Only objects read from jsonFile using "--fromJSON" flag
+            // have a saved position
             return nullptr;
         } else {
             // Added source_info for jsonObject when "--fromJSON" flag is used
-            // which parameters are saved in srcInfo fileds(filename, line, column and srcBrief)
+            // which parameters are saved in srcInfo (filename, line, column and srcBrief)
             auto json1 = new Util::JsonObject();
-            json1->emplace("filename", srcInfo.filename);
-            json1->emplace("line", srcInfo.line);
-            json1->emplace("column", srcInfo.column);
-            json1->emplace("source_fragment", srcInfo.srcBrief);
+            json1->emplace("filename", saved->filename);
+            json1->emplace("line", saved->line);
+            json1->emplace("column", saved->column);
+            json1->emplace("source_fragment", saved->srcBrief);
             return json1;
         }
     } else {
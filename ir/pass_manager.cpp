@@ -61,10 +61,15 @@ const IR::Node *PassManager::apply_visitor(const IR::Node *program, const char *
         if (auto b = dynamic_cast<Backtrack *>(v)) {
             if (!b->never_backtracks()) {
                 backup.emplace_back(it, program); } }
+        if (skipPass(v, program)) {
+            LOG1(log_indent << name() << " skipping " << v->name() << ", already converged");
+            it++;
+            continue; }
         try {
             try {
                 LOG1(log_indent << name() << " invoking " << v->name());
                 auto after = program->apply(**it);
+                passApplied(v, program, after);
                 if (LOGGING(3)) {
                     size_t maxmem, mem = gc_mem_inuse(&maxmem);  // triggers gc
                     LOG3(log_indent << "heap after " << v->name() << ": in use " <<
@@ -123,10 +128,24 @@ void PassManager::runDebugHooks(const char* visitorName, const IR::Node* program
         h(name(), seqNo, visitorName, program);
 }
 
+bool PassRepeated::skipPass(const Visitor *v, const IR::Node *program) {
+    if (!skipConverged) return false;
+    auto it = converged.find(v);
+    return it != converged.end() && it->second == program;
+}
+
+void PassRepeated::passApplied(const Visitor *v, const IR::Node *before, const IR::Node *after) {
+    if (before == after)
+        converged[v] = before;
+    else
+        converged.erase(v);
+}
+
 const IR::Node *PassRepeated::apply_visitor(const IR::Node *program, const char *name) {
     bool done = false;
     unsigned iterations = 0;
     unsigned initial_error_count = ::errorCount();
+    converged.clear();
     while (!done) {
         LOG5("PassRepeated state is:\n" << dumpToString(program));
         running = true;
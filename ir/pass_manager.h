@@ -17,6 +17,7 @@ limitations under the License.
 #ifndef _IR_PASS_MANAGER_H_
 #define _IR_PASS_MANAGER_H_
 
+#include <map>
 #include "visitor.h"
 
 typedef std::function<void(const char* manager, unsigned seqNo,
@@ -34,6 +35,9 @@ class PassManager : virtual public Visitor, virtual public Backtrack {
     bool                running = false;
     unsigned            seqNo = 0;
     void runDebugHooks(const char* visitorName, const IR::Node* node);
+    // Hooks allowing subclasses to skip passes known to leave the program unchanged
+    virtual bool skipPass(const Visitor *, const IR::Node *) { return false; }
+    virtual void passApplied(const Visitor *, const IR::Node *, const IR::Node *) {}
     profile_t init_apply(const IR::Node *root) override {
         running = true;
         return Visitor::init_apply(root); }
@@ -110,12 +114,25 @@ class OnBacktrack : virtual public Visitor, virtual public Backtrack {
 // Repeat a pass until convergence (or up to a fixed number of repeats)
 class PassRepeated : virtual public PassManager {
     unsigned            repeats;  // 0 = until convergence
+    // When set, a pass is not rerun on a program it already left unchanged.
+    // This is only valid when each pass recomputes the state it depends on
+    // (e.g., runs its own TypeChecking) rather than relying on side effects
+    // of the previous passes.
+    bool                skipConverged = false;
+    // Program each pass was last applied to, when it did not change it
+    std::map<const Visitor *, const IR::Node *> converged;
+
+ protected:
+    bool skipPass(const Visitor *v, const IR::Node *program) override;
+    void passApplied(const Visitor *v, const IR::Node *before, const IR::Node *after) override;
+
  public:
     PassRepeated() : repeats(0) {}
     PassRepeated(const std::initializer_list<VisitorRef> &init, unsigned repeats = 0) :
             PassManager(init), repeats(repeats) {}
     const IR::Node *apply_visitor(const IR::Node *, const char * = 0) override;
     PassRepeated *setRepeats(unsigned repeats) { this->repeats = repeats; return this; }
+    PassRepeated *setSkipConverged(bool skip = true) { skipConverged = skip; return this; }
     PassRepeated *clone() const override { return new PassRepeated(*this); }
 };
 
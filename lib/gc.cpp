@@ -213,3 +213,14 @@ size_t gc_mem_inuse(size_t *max) {
     return 0;
 #endif
 }
+
+size_t gc_object_size(const void *ptr) {
+#if HAVE_LIBGC
+    if (ptr == nullptr || GC_base(const_cast<void *>(ptr)) != ptr)
+        return 0;
+    return GC_size(ptr);
+#else
+    (void)ptr;
+    return 0;
+#endif
+}
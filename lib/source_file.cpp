@@ -156,11 +156,16 @@ void InputSources::mapLine(cstring file, unsigned originalSourceLineNo) {
     if (sealed)
         BUG("Changing mapping to sealed InputSources");
     unsigned lineno = getCurrentLineNumber();
-    line_file_map.emplace(lineno, SourceFileLine(file, originalSourceLineNo));
+    // Lines are mapped in increasing order; the first mapping of a line wins.
+    if (!line_file_map.empty() && line_file_map.back().first >= lineno)
+        return;
+    line_file_map.emplace_back(lineno, SourceFileLine(file, originalSourceLineNo));
 }
 
 SourceFileLine InputSources::getSourceLine(unsigned line) const {
-    auto it = line_file_map.upper_bound(line);
+    auto it = std::upper_bound(
+        line_file_map.begin(), line_file_map.end(), line,
+        [](unsigned l, const std::pair<unsigned, SourceFileLine> &e) { return l < e.first; });
     if (it == line_file_map.begin())
         // There must be always something mapped to line 0
         BUG("No source information for line %1%", line);
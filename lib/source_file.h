@@ -139,16 +139,19 @@ SourceInfo can also be "invalid"
 */
 class SourceInfo final {
  public:
-    cstring filename = "";
-    int line = -1;
-    int column = -1;
-    cstring srcBrief = "";
-    SourceInfo(cstring filename, int line, int column, cstring srcBrief) {
-        this->filename = filename;
-        this->line = line;
-        this->column = column;
-        this->srcBrief = srcBrief;
-    }
+    /// Position in the original sources of a node read back from a JSON dump
+    /// of the IR, for which no InputSources are available.  Kept out of line,
+    /// since all other SourceInfos (i.e., the ones of almost every node) do
+    /// not need it.
+    struct SavedPosition {
+        cstring filename;
+        int line;
+        int column;
+        cstring srcBrief;
+    };
+
+    SourceInfo(cstring filename, int line, int column, cstring srcBrief)
+        : saved(new SavedPosition{filename, line, column, srcBrief}) {}
     /// Creates an "invalid" SourceInfo
     SourceInfo()
         : sources(nullptr), start(SourcePosition()), end(SourcePosition()) {}
@@ -213,6 +216,10 @@ class SourceInfo final {
     const SourcePosition& getEnd() const
     { return this->end; }
 
+    /// The position read from JSON, or nullptr if this was not read from JSON.
+    const SavedPosition* getSavedPosition() const
+    { return this->saved; }
+
     /**
        True if this comes 'before' this source position.
        'invalid' source positions come first.
@@ -234,6 +241,7 @@ class SourceInfo final {
     const InputSources* sources = nullptr;
     SourcePosition start = SourcePosition();
     SourcePosition end = SourcePosition();
+    const SavedPosition* saved = nullptr;
 };
 
 class IHasSourceInfo {
@@ -337,7 +345,8 @@ class InputSources final {
     /// Input program that is being currently compiled; there can be only one.
     bool sealed;
 
-    std::map<unsigned, SourceFileLine> line_file_map;
+    /// Pairs (line number, original source line), sorted by line number.
+    std::vector<std::pair<unsigned, SourceFileLine>> line_file_map;
 
     /// Each line also stores the end-of-line character(s)
     std::vector<std::string> contents;
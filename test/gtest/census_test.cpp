@@ -0,0 +1,98 @@
+/*
+Copyright 2026 The P4 Language Consortium
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ir/census.h"
+#include "ir/ir.h"
+#include "helpers.h"
+#include "frontends/common/options.h"
+
+namespace Test {
+
+class NodeCensusTest : public P4CTest { };
+
+TEST_F(NodeCensusTest, CountsDistinctNodesPerType) {
+    auto one = new IR::Constant(1);
+    auto sum = new IR::Add(new IR::Add(one, one), new IR::Constant(2));
+
+    NodeCensus census;
+    sum->apply(census);
+    EXPECT_EQ(2u, census.byType["Add"].count);
+    // The constant shared by the inner addition is counted once.
+    EXPECT_EQ(2u, census.byType["Constant"].count);
+
+    size_t count = 0, bytes = 0;
+    for (auto& t : census.byType) {
+        count += t.second.count;
+        bytes += t.second.bytes;
+    }
+    EXPECT_EQ(count, census.total.count);
+    EXPECT_EQ(bytes, census.total.bytes);
+}
+
+TEST_F(NodeCensusTest, JSONOutput) {
+    NodeCensus census;
+    (new IR::Add(new IR::Constant(1), new IR::Constant(2)))->apply(census);
+
+    std::stringstream out;
+    census.toJSON(out, "SomePass");
+    auto json = out.str();
+    for (auto field : {"\"pass\"", "\"SomePass\"", "\"nodes\"", "\"node_bytes\"",
+                       "\"node_types\"", "\"Add\"", "\"Constant\"", "\"cstrings\"",
+                       "\"cstring_bytes\"", "\"heap_in_use\"", "\"heap_size\""})
+        EXPECT_NE(std::string::npos, json.find(field)) << field << " missing in " << json;
+}
+
+// --memoryCensus writes a census after the matching passes, next to the
+// other dumps.
+TEST_F(NodeCensusTest, MemoryCensusOption) {
+    char dir[] = "/tmp/p4c-census-XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(dir));
+
+    CompilerOptions options;
+    std::vector<const char*> args = {"(test)", "--memoryCensus", "Census", "--dump", dir};
+    options.process(args.size(), const_cast<char* const*>(args.data()));
+    ASSERT_EQ(0u, ::errorCount());
+    options.file = "prog.p4";
+
+    auto hook = options.getDebugHook();
+    auto program = new IR::Add(new IR::Constant(1), new IR::Constant(2));
+    hook("FrontEnd", 3, "P4::CensusPass", program);
+    hook("FrontEnd", 4, "P4::OtherPass", program);
+
+    std::string file = std::string(dir) + "/prog-FrontEnd_3_CensusPass-census.json";
+    std::ifstream census(file);
+    ASSERT_TRUE(census.good()) << file << " was not written";
+    std::stringstream content;
+    content << census.rdbuf();
+    EXPECT_NE(std::string::npos, content.str().find("\"FrontEnd_3_CensusPass\""));
+    EXPECT_NE(std::string::npos, content.str().find("\"Add\""));
+
+    std::string other = std::string(dir) + "/prog-FrontEnd_4_OtherPass-census.json";
+    EXPECT_FALSE(std::ifstream(other).good());
+
+    unlink(file.c_str());
+    rmdir(dir);
+}
+
+}  // namespace Test
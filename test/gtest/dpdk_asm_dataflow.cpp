@@ -0,0 +1,195 @@
+/*
+Copyright 2026 The P4 Language Consortium
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "gtest/gtest.h"
+#include "ir/ir.h"
+#include "backends/dpdk/dpdkAsmDataflow.h"
+
+namespace Test {
+
+namespace {
+
+const IR::Expression *meta(cstring field) {
+    return new IR::Member(new IR::PathExpression("m"), field);
+}
+
+const IR::Expression *hdrField(cstring header, cstring field) {
+    return new IR::Member(new IR::Member(new IR::PathExpression("h"), header), field);
+}
+
+const IR::Constant *value(int v) {
+    return new IR::Constant(IR::Type_Bits::get(32), v);
+}
+
+const cstring outputPort = "pna_main_output_metadata_output_port";
+
+/// Builds a program with a 32-bit metadata field for each of a, b, c and
+/// the output port, whose apply block is 'stmts', runs the dataflow
+/// optimization on it and returns the optimized apply block.
+IR::IndexedVector<IR::DpdkAsmStatement>
+optimize(const IR::IndexedVector<IR::DpdkAsmStatement> &stmts,
+         const IR::IndexedVector<IR::DpdkAction> &actions = {}) {
+    IR::IndexedVector<IR::StructField> metaFields;
+    for (cstring f : {cstring("a"), cstring("b"), cstring("c"), outputPort})
+        metaFields.push_back(new IR::StructField(f, IR::Type_Bits::get(32)));
+    auto annotations = new IR::Annotations(
+        {new IR::Annotation(IR::ID("__metadata__"), IR::Vector<IR::Expression>())});
+    IR::IndexedVector<IR::DpdkStructType> structs;
+    structs.push_back(new IR::DpdkStructType(Util::SourceInfo(), IR::ID("main_metadata_t"),
+                                             annotations, metaFields));
+
+    IR::IndexedVector<IR::DpdkAsmStatement> statements;
+    statements.push_back(new IR::DpdkListStatement(stmts));
+    auto program = new IR::DpdkAsmProgram(
+        IR::IndexedVector<IR::DpdkHeaderType>(), structs,
+        IR::IndexedVector<IR::DpdkExternDeclaration>(), actions,
+        IR::IndexedVector<IR::DpdkTable>(), IR::IndexedVector<IR::DpdkSelector>(),
+        IR::IndexedVector<IR::DpdkLearner>(), statements,
+        IR::IndexedVector<IR::DpdkDeclaration>());
+
+    DPDK::DataflowOptimization dataflow;
+    auto result = program->apply(dataflow)->to<IR::DpdkAsmProgram>();
+    EXPECT_NE(nullptr, result);
+    auto list = result->statements.at(0)->to<IR::DpdkListStatement>();
+    EXPECT_NE(nullptr, list);
+    return list->statements;
+}
+
+bool isMov(const IR::DpdkAsmStatement *s, cstring dst) {
+    auto mv = s->to<IR::DpdkMovStatement>();
+    return mv && mv->dst->toString() == dst;
+}
+
+}  // namespace
+
+class DpdkAsmDataflow : public ::testing::Test {};
+
+// A constant stored before a label is still known after it, which folds the
+// conditional jump and makes the block it skips unreachable.
+TEST_F(DpdkAsmDataflow, FoldJumpAcrossLabel) {
+    IR::IndexedVector<IR::DpdkAsmStatement> stmts;
+    stmts.push_back(new IR::DpdkMovStatement(meta("a"), value(5)));
+    stmts.push_back(new IR::DpdkLabelStatement("label_1"));
+    stmts.push_back(new IR::DpdkJmpEqualStatement("label_2", meta("a"), value(5)));
+    stmts.push_back(new IR::DpdkMovStatement(meta(outputPort), value(1)));
+    stmts.push_back(new IR::DpdkLabelStatement("label_2"));
+    stmts.push_back(new IR::DpdkMovStatement(meta(outputPort), value(2)));
+    stmts.push_back(new IR::DpdkTxStatement(meta(outputPort)));
+
+    auto result = optimize(stmts);
+    // The store to m.a is dead once the jump no longer reads it.
+    ASSERT_EQ(5u, result.size());
+    EXPECT_TRUE(result.at(0)->is<IR::DpdkLabelStatement>());
+    auto jmp = result.at(1)->to<IR::DpdkJmpLabelStatement>();
+    ASSERT_NE(nullptr, jmp);
+    EXPECT_EQ("LABEL_2", jmp->label);
+    EXPECT_TRUE(result.at(2)->is<IR::DpdkLabelStatement>());
+    auto mv = result.at(3)->to<IR::DpdkMovStatement>();
+    ASSERT_NE(nullptr, mv);
+    EXPECT_EQ(2, mv->src->to<IR::Constant>()->asInt());
+    EXPECT_TRUE(result.at(4)->is<IR::DpdkTxStatement>());
+}
+
+// A jump which is never taken is removed together with its target when no
+// other jump reaches it.
+TEST_F(DpdkAsmDataflow, RemoveUnreachableBlock) {
+    IR::IndexedVector<IR::DpdkAsmStatement> stmts;
+    stmts.push_back(new IR::DpdkMovStatement(meta("a"), value(5)));
+    stmts.push_back(new IR::DpdkJmpEqualStatement("label_1", meta("a"), value(6)));
+    stmts.push_back(new IR::DpdkMovStatement(meta(outputPort), value(1)));
+    stmts.push_back(new IR::DpdkTxStatement(meta(outputPort)));
+    stmts.push_back(new IR::DpdkLabelStatement("label_1"));
+    stmts.push_back(new IR::DpdkMovStatement(meta(outputPort), value(2)));
+    stmts.push_back(new IR::DpdkTxStatement(meta(outputPort)));
+
+    auto result = optimize(stmts);
+    ASSERT_EQ(2u, result.size());
+    auto mv = result.at(0)->to<IR::DpdkMovStatement>();
+    ASSERT_NE(nullptr, mv);
+    EXPECT_EQ(1, mv->src->to<IR::Constant>()->asInt());
+    EXPECT_TRUE(result.at(1)->is<IR::DpdkTxStatement>());
+}
+
+// Values which differ on the paths joining at a label are not propagated.
+TEST_F(DpdkAsmDataflow, NoFoldingOnDisagreeingPaths) {
+    IR::IndexedVector<IR::DpdkAsmStatement> stmts;
+    stmts.push_back(new IR::DpdkJmpEqualStatement("label_1", meta("b"), value(0)));
+    stmts.push_back(new IR::DpdkMovStatement(meta("a"), value(5)));
+    stmts.push_back(new IR::DpdkJmpLabelStatement("label_2"));
+    stmts.push_back(new IR::DpdkLabelStatement("label_1"));
+    stmts.push_back(new IR::DpdkMovStatement(meta("a"), value(6)));
+    stmts.push_back(new IR::DpdkLabelStatement("label_2"));
+    stmts.push_back(new IR::DpdkJmpEqualStatement("label_3", meta("a"), value(5)));
+    stmts.push_back(new IR::DpdkMovStatement(meta(outputPort), value(1)));
+    stmts.push_back(new IR::DpdkLabelStatement("label_3"));
+
+    auto result = optimize(stmts);
+    ASSERT_EQ(stmts.size(), result.size());
+    EXPECT_TRUE(result.at(6)->is<IR::DpdkJmpEqualStatement>());
+    EXPECT_TRUE(isMov(result.at(1), "m.a"));
+    EXPECT_TRUE(isMov(result.at(4), "m.a"));
+}
+
+// Only the header fields and the metadata read by the target are live at
+// the end of the apply block.
+TEST_F(DpdkAsmDataflow, KeepAliveAtExit) {
+    IR::IndexedVector<IR::DpdkAsmStatement> stmts;
+    stmts.push_back(new IR::DpdkMovStatement(meta("a"), value(1)));
+    stmts.push_back(new IR::DpdkMovStatement(hdrField("ethernet", "etherType"), value(2)));
+    stmts.push_back(new IR::DpdkMovStatement(meta(outputPort), value(3)));
+
+    auto result = optimize(stmts);
+    ASSERT_EQ(2u, result.size());
+    EXPECT_TRUE(isMov(result.at(0), "h.ethernet.etherType"));
+    EXPECT_TRUE(isMov(result.at(1), "m." + outputPort));
+}
+
+// A recirculated packet carries all of its metadata back into the pipeline.
+TEST_F(DpdkAsmDataflow, RecirculationKeepsMetadataLive) {
+    IR::IndexedVector<IR::DpdkAsmStatement> stmts;
+    stmts.push_back(new IR::DpdkMovStatement(meta("a"), value(1)));
+    stmts.push_back(new IR::DpdkMovStatement(meta(outputPort), value(3)));
+
+    IR::IndexedVector<IR::DpdkAsmStatement> body;
+    body.push_back(new IR::DpdkRecirculateStatement());
+    body.push_back(new IR::DpdkReturnStatement());
+    IR::IndexedVector<IR::DpdkAction> actions;
+    actions.push_back(new IR::DpdkAction(body, "do_recirculate", IR::ParameterList()));
+
+    auto result = optimize(stmts, actions);
+    ASSERT_EQ(2u, result.size());
+    EXPECT_TRUE(isMov(result.at(0), "m.a"));
+}
+
+// Instructions with unknown effects, such as a table lookup, may read and
+// write any field: stores before them stay and no value is known after them.
+TEST_F(DpdkAsmDataflow, BarrierClearsFacts) {
+    IR::IndexedVector<IR::DpdkAsmStatement> stmts;
+    stmts.push_back(new IR::DpdkMovStatement(meta("a"), value(5)));
+    stmts.push_back(new IR::DpdkMovStatement(meta("c"), value(7)));
+    stmts.push_back(new IR::DpdkApplyStatement("tbl"));
+    stmts.push_back(new IR::DpdkJmpEqualStatement("label_1", meta("a"), value(5)));
+    stmts.push_back(new IR::DpdkMovStatement(meta(outputPort), value(1)));
+    stmts.push_back(new IR::DpdkLabelStatement("label_1"));
+
+    auto result = optimize(stmts);
+    ASSERT_EQ(stmts.size(), result.size());
+    EXPECT_TRUE(isMov(result.at(0), "m.a"));
+    EXPECT_TRUE(isMov(result.at(1), "m.c"));
+    EXPECT_TRUE(result.at(3)->is<IR::DpdkJmpEqualStatement>());
+}
+
+}  // namespace Test
@@ -0,0 +1,162 @@
+/*
+Copyright 2026 The P4 Language Consortium
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ir/ir.h"
+#include "ir/json_generator.h"
+#include "helpers.h"
+
+#include "frontends/common/parseInput.h"
+#include "frontends/p4/frontend.h"
+#include "frontends/p4/toP4/toP4.h"
+
+namespace Test {
+
+namespace {
+
+const char* incrementSource = R"(
+    header H { bit<8> f; }
+    control c(inout H h) { apply { h.f = h.f + 1; } }
+    control proto(inout H h);
+    package top(proto p);
+    top(c()) main;
+)";
+
+const char* constantSource = R"(
+    header H { bit<8> f; }
+    control c(inout H h) { apply { h.f = 2; } }
+    control proto(inout H h);
+    package top(proto p);
+    top(c()) main;
+)";
+
+/// A temporary directory holding the front-end cache, removed with its
+/// content at the end of the test.
+class CacheDir {
+    std::string path;
+
+ public:
+    CacheDir() {
+        char name[] = "/tmp/p4c-frontend-cache-XXXXXX";
+        if (mkdtemp(name) != nullptr)
+            path = name;
+    }
+    ~CacheDir() {
+        if (path.empty())
+            return;
+        for (auto& file : files())
+            unlink(file.c_str());
+        rmdir(path.c_str());
+    }
+    cstring get() const { return path; }
+    std::vector<std::string> files() const {
+        std::vector<std::string> result;
+        if (DIR* dir = opendir(path.c_str())) {
+            while (auto entry = readdir(dir)) {
+                std::string name = entry->d_name;
+                if (name != "." && name != "..")
+                    result.push_back(path + "/" + name);
+            }
+            closedir(dir);
+        }
+        return result;
+    }
+};
+
+const IR::P4Program* runFrontEnd(const std::string& source, cstring cacheDir) {
+    auto program = P4::parseP4String(source, CompilerOptions::FrontendVersion::P4_16);
+    if (program == nullptr)
+        return nullptr;
+    CompilerOptions options;
+    options.langVersion = CompilerOptions::FrontendVersion::P4_16;
+    options.frontendCacheDir = cacheDir;
+    return P4::FrontEnd().run(options, program);
+}
+
+std::string toP4(const IR::P4Program* program) {
+    std::stringstream out;
+    P4::ToP4 toP4(&out, false);
+    program->apply(toP4);
+    return out.str();
+}
+
+}  // namespace
+
+class FrontEndCache : public P4CTest { };
+
+TEST_F(FrontEndCache, SecondRunProducesIdenticalOutput) {
+    CacheDir cache;
+    ASSERT_FALSE(cache.get().isNullOrEmpty());
+    auto source = P4_SOURCE(P4Headers::CORE, incrementSource);
+
+    auto first = runFrontEnd(source, cache.get());
+    ASSERT_TRUE(first != nullptr);
+    ASSERT_EQ(0u, ::diagnosticCount());
+    EXPECT_EQ(1u, cache.files().size());
+
+    auto second = runFrontEnd(source, cache.get());
+    ASSERT_TRUE(second != nullptr);
+    EXPECT_EQ(toP4(first), toP4(second));
+    // No temporary file is left behind.
+    EXPECT_EQ(1u, cache.files().size());
+}
+
+TEST_F(FrontEndCache, SecondRunUsesCachedResult) {
+    CacheDir cache;
+    ASSERT_FALSE(cache.get().isNullOrEmpty());
+    auto source = P4_SOURCE(P4Headers::CORE, incrementSource);
+
+    auto first = runFrontEnd(source, cache.get());
+    ASSERT_TRUE(first != nullptr);
+    auto files = cache.files();
+    ASSERT_EQ(1u, files.size());
+
+    // Replace the cached result with the one of a different program: a
+    // second compilation which returns it did not run the front-end passes.
+    auto other = runFrontEnd(P4_SOURCE(P4Headers::CORE, constantSource), nullptr);
+    ASSERT_TRUE(other != nullptr);
+    {
+        std::ofstream json(files.front());
+        JSONGenerator(json, true) << other << std::endl;
+    }
+
+    auto second = runFrontEnd(source, cache.get());
+    ASSERT_TRUE(second != nullptr);
+    EXPECT_EQ(toP4(other), toP4(second));
+    EXPECT_NE(toP4(first), toP4(second));
+}
+
+TEST_F(FrontEndCache, DifferentProgramsUseDifferentEntries) {
+    CacheDir cache;
+    ASSERT_FALSE(cache.get().isNullOrEmpty());
+
+    auto first = runFrontEnd(P4_SOURCE(P4Headers::CORE, incrementSource), cache.get());
+    ASSERT_TRUE(first != nullptr);
+    auto second = runFrontEnd(P4_SOURCE(P4Headers::CORE, constantSource), cache.get());
+    ASSERT_TRUE(second != nullptr);
+    EXPECT_EQ(2u, cache.files().size());
+    EXPECT_NE(toP4(first), toP4(second));
+}
+
+}  // namespace Test
@@ -43,4 +43,31 @@ TEST_F(P4C_IR, Transform) {
     EXPECT_EQ(e, n);
 }
 
+TEST_F(P4C_IR, PassRepeatedSkipConverged) {
+    struct Increment : public Transform {
+        const IR::Node* postorder(IR::Constant* c) override {
+            if (c->value < 3)
+                return new IR::Constant(c->value + 1);
+            return c;
+        }
+    };
+    struct CountApply : public Inspector {
+        explicit CountApply(unsigned* count) : count(count) { }
+        bool preorder(const IR::Node*) override { ++*count; return false; }
+        unsigned* count;
+    };
+
+    for (bool skip : { false, true }) {
+        unsigned count = 0;
+        PassRepeated passes({ new Increment, new CountApply(&count) });
+        passes.setSkipConverged(skip);
+        auto n = (new IR::Constant(0))->apply(passes);
+        ASSERT_TRUE(n->is<IR::Constant>());
+        EXPECT_EQ(3, n->to<IR::Constant>()->asInt());
+        // The last iteration does not change the program, so the inspector
+        // is not rerun on it when skipping converged passes.
+        EXPECT_EQ(skip ? 3u : 4u, count);
+    }
+}
+
 }  // namespace Test
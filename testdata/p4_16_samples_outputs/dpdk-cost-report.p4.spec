@@ -0,0 +1,132 @@
+
+struct ethernet_t {
+	bit<48> dstAddr
+	bit<48> srcAddr
+	bit<16> etherType
+}
+
+struct ipv4_t {
+	bit<8> version_ihl
+	bit<8> diffserv
+	bit<16> totalLen
+	bit<16> identification
+	bit<16> flags_fragOffset
+	bit<8> ttl
+	bit<8> protocol
+	bit<16> hdrChecksum
+	bit<32> srcAddr
+	bit<32> dstAddr
+}
+
+struct psa_ingress_output_metadata_t {
+	bit<8> class_of_service
+	bit<8> clone
+	bit<16> clone_session_id
+	bit<8> drop
+	bit<8> resubmit
+	bit<32> multicast_group
+	bit<32> egress_port
+}
+
+struct psa_egress_output_metadata_t {
+	bit<8> clone
+	bit<16> clone_session_id
+	bit<8> drop
+}
+
+struct psa_egress_deparser_input_metadata_t {
+	bit<32> egress_port
+}
+
+struct forward_arg_t {
+	bit<32> port
+	bit<48> dmac
+}
+
+struct set_nexthop_arg_t {
+	bit<16> nexthop
+	bit<8> qos
+}
+
+struct metadata {
+	bit<32> psa_ingress_input_metadata_ingress_port
+	bit<8> psa_ingress_output_metadata_drop
+	bit<32> psa_ingress_output_metadata_egress_port
+	bit<16> local_metadata_nexthop
+	bit<8> local_metadata_qos
+}
+metadata instanceof metadata
+
+header ethernet instanceof ethernet_t
+header ipv4 instanceof ipv4_t
+
+action drop_1 args none {
+	mov m.psa_ingress_output_metadata_drop 1
+	return
+}
+
+action drop_2 args none {
+	mov m.psa_ingress_output_metadata_drop 1
+	return
+}
+
+action set_nexthop args instanceof set_nexthop_arg_t {
+	mov m.local_metadata_nexthop t.nexthop
+	mov m.local_metadata_qos t.qos
+	add h.ipv4.ttl 0xff
+	return
+}
+
+action forward args instanceof forward_arg_t {
+	mov h.ethernet.srcAddr h.ethernet.dstAddr
+	mov h.ethernet.dstAddr t.dmac
+	mov m.psa_ingress_output_metadata_egress_port t.port
+	mov m.psa_ingress_output_metadata_drop 0
+	return
+}
+
+table route {
+	key {
+		h.ipv4.dstAddr exact
+	}
+	actions {
+		set_nexthop
+		drop_1
+	}
+	default_action drop_1 args none 
+	size 0x10000
+}
+
+
+table nexthop {
+	key {
+		m.local_metadata_nexthop exact
+	}
+	actions {
+		forward
+		drop_2
+	}
+	default_action drop_2 args none 
+	size 0x10000
+}
+
+
+apply {
+	rx m.psa_ingress_input_metadata_ingress_port
+	mov m.psa_ingress_output_metadata_drop 0x0
+	extract h.ethernet
+	jmpeq INGRESSPARSERIMPL_PARSE_IPV4 h.ethernet.etherType 0x800
+	jmp INGRESSPARSERIMPL_ACCEPT
+	INGRESSPARSERIMPL_PARSE_IPV4 :	extract h.ipv4
+	INGRESSPARSERIMPL_ACCEPT :	jmpnv LABEL_END h.ipv4
+	table route
+	jmpeq LABEL_END m.local_metadata_qos 0x0
+	table nexthop
+	LABEL_END :	jmpneq LABEL_DROP m.psa_ingress_output_metadata_drop 0x0
+	emit h.ethernet
+	emit h.ipv4
+	tx m.psa_ingress_output_metadata_egress_port
+	LABEL_DROP :	drop
+}
+
+
@@ -0,0 +1,174 @@
+
+struct ethernet_t {
+	bit<48> dstAddr
+	bit<48> srcAddr
+	bit<16> etherType
+}
+
+struct ipv4_t {
+	bit<8> version_ihl
+	bit<8> diffserv
+	bit<16> totalLen
+	bit<16> identification
+	bit<16> flags_fragOffset
+	bit<8> ttl
+	bit<8> protocol
+	bit<16> hdrChecksum
+	bit<32> srcAddr
+	bit<32> dstAddr
+}
+
+struct psa_ingress_output_metadata_t {
+	bit<8> class_of_service
+	bit<8> clone
+	bit<16> clone_session_id
+	bit<8> drop
+	bit<8> resubmit
+	bit<32> multicast_group
+	bit<32> egress_port
+}
+
+struct psa_egress_output_metadata_t {
+	bit<8> clone
+	bit<16> clone_session_id
+	bit<8> drop
+}
+
+struct psa_egress_deparser_input_metadata_t {
+	bit<32> egress_port
+}
+
+struct forward_1_arg_t {
+	bit<32> port
+}
+
+struct forward_arg_t {
+	bit<32> port
+}
+
+struct set_classes_arg_t {
+	bit<16> vrf
+	bit<32> src_class
+	bit<32> dst_class
+}
+
+struct metadata {
+	bit<16> local_metadata_vrf
+	bit<32> local_metadata_src_class
+	bit<32> local_metadata_dst_class
+	bit<64> local_metadata_flow_id
+	bit<8> local_metadata_dscp
+	bit<32> psa_ingress_input_metadata_ingress_port
+	bit<8> psa_ingress_output_metadata_drop
+	bit<32> psa_ingress_output_metadata_egress_port
+	bit<64> Ingress_tmp_0
+	bit<64> Ingress_tmp_2
+}
+metadata instanceof metadata
+
+header ethernet instanceof ethernet_t
+header ipv4 instanceof ipv4_t
+
+action drop_1 args none {
+	mov m.psa_ingress_output_metadata_drop 1
+	return
+}
+
+action drop_2 args none {
+	mov m.psa_ingress_output_metadata_drop 1
+	return
+}
+
+action drop_3 args none {
+	mov m.psa_ingress_output_metadata_drop 1
+	return
+}
+
+action set_classes args instanceof set_classes_arg_t {
+	mov m.local_metadata_vrf t.vrf
+	mov m.local_metadata_src_class t.src_class
+	mov m.local_metadata_dst_class t.dst_class
+	mov m.Ingress_tmp_0 h.ethernet.srcAddr
+	shl m.Ingress_tmp_0 0x10
+	mov m.Ingress_tmp_2 h.ethernet.etherType
+	and m.Ingress_tmp_2 0x1ffff
+	mov m.local_metadata_flow_id m.Ingress_tmp_0
+	or m.local_metadata_flow_id m.Ingress_tmp_2
+	mov m.local_metadata_dscp h.ipv4.diffserv
+	return
+}
+
+action forward args instanceof forward_arg_t {
+	mov m.psa_ingress_output_metadata_egress_port t.port
+	mov m.psa_ingress_output_metadata_drop 0
+	return
+}
+
+action forward_1 args instanceof forward_1_arg_t {
+	mov m.psa_ingress_output_metadata_egress_port t.port
+	mov m.psa_ingress_output_metadata_drop 0
+	return
+}
+
+table classify {
+	key {
+		h.ipv4.srcAddr exact
+		h.ipv4.dstAddr exact
+	}
+	actions {
+		set_classes
+		drop_1
+	}
+	default_action drop_1 args none 
+	size 0x10000
+}
+
+
+table acl {
+	key {
+		m.local_metadata_vrf exact
+		m.local_metadata_src_class exact
+		m.local_metadata_dst_class exact
+	}
+	actions {
+		forward
+		drop_2
+	}
+	default_action drop_2 args none 
+	size 0x10000
+}
+
+
+table flows {
+	key {
+		m.local_metadata_flow_id exact
+		m.local_metadata_dscp exact
+	}
+	actions {
+		forward_1
+		drop_3
+	}
+	default_action drop_3 args none 
+	size 0x10000
+}
+
+
+apply {
+	rx m.psa_ingress_input_metadata_ingress_port
+	mov m.psa_ingress_output_metadata_drop 0x0
+	extract h.ethernet
+	jmpeq INGRESSPARSERIMPL_PARSE_IPV4 h.ethernet.etherType 0x800
+	jmp INGRESSPARSERIMPL_ACCEPT
+	INGRESSPARSERIMPL_PARSE_IPV4 :	extract h.ipv4
+	INGRESSPARSERIMPL_ACCEPT :	jmpnv LABEL_END h.ipv4
+	table classify
+	table acl
+	table flows
+	LABEL_END :	jmpneq LABEL_DROP m.psa_ingress_output_metadata_drop 0x0
+	emit h.ethernet
+	emit h.ipv4
+	tx m.psa_ingress_output_metadata_egress_port
+	LABEL_DROP :	drop
+}
+
+